@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
 
 TEST(S21arrayTest, DefaultConstructor) {
   s21::Array<double, 5> arr2;
@@ -289,3 +290,19 @@ TEST(S21ARRAY, operatoreqtrue) {
   s21::Array<float, 3> zero_n2 = {0.0, 0.0, 0.0};
   EXPECT_TRUE(zero_n1 == zero_n2);
 }
+
+TEST(S21arrayTest, AllocatorOwnsStorage) {
+  s21_test::CountingAllocator<int> alloc;
+  auto stats = alloc.stats();
+  {
+    s21::Array<int, 4, s21_test::CountingAllocator<int>> arr({1, 2}, alloc);
+    EXPECT_EQ(stats->allocations, 1U);
+    EXPECT_EQ(stats->live_objects, 4U);
+    EXPECT_EQ(arr[1], 2);
+    EXPECT_EQ(arr[3], 0);
+    auto copy = arr;
+    EXPECT_EQ(stats->live_objects, 8U);
+    EXPECT_EQ(copy[0], 1);
+  }
+  EXPECT_EQ(stats->live_objects, 0U);
+}
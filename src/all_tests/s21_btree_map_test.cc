@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+
+namespace {
+
+template <typename Map, typename Expected>
+void ExpectSameItems(const Map &my_map, const Expected &expected) {
+  ASSERT_EQ(my_map.size(), expected.size());
+  auto my_it = my_map.begin();
+  for (const auto &item : expected) {
+    ASSERT_TRUE(my_it != my_map.end());
+    ASSERT_EQ(my_it->first, item.first);
+    ASSERT_EQ(my_it->second, item.second);
+    ++my_it;
+  }
+  ASSERT_TRUE(my_it == my_map.end());
+  for (auto std_it = expected.rbegin(); std_it != expected.rend(); ++std_it) {
+    --my_it;
+    ASSERT_EQ(my_it->first, std_it->first);
+  }
+  ASSERT_TRUE(my_it == my_map.begin());
+}
+
+std::vector<int> RandomKeys(int count, unsigned seed) {
+  std::vector<int> keys(count);
+  for (int &key : keys) {
+    seed = seed * 1103515245U + 12345U;
+    key = static_cast<int>(seed >> 1);
+  }
+  return keys;
+}
+
+}  // namespace
+
+TEST(BtreeMap, DefaultConstructor) {
+  s21::btree_map<int, int> my_map;
+  EXPECT_TRUE(my_map.empty());
+  EXPECT_EQ(my_map.size(), 0U);
+  EXPECT_EQ(my_map.height(), 0U);
+  EXPECT_TRUE(my_map.begin() == my_map.end());
+  EXPECT_FALSE(my_map.contains(1));
+  EXPECT_EQ(my_map.erase(1), 0U);
+}
+
+TEST(BtreeMap, NodeSizeFillsCacheLines) {
+  // 32 eight-byte pairs fit in 256 bytes, rounded down to an odd count
+  using small_map = s21::btree_map<int, int>;
+  EXPECT_EQ(small_map::node_size(), 31U);
+  EXPECT_LE(small_map::node_size() * sizeof(small_map::value_type), 256U);
+  using char_map = s21::btree_map<char, char>;
+  EXPECT_LE(char_map::node_size() * sizeof(char_map::value_type), 256U);
+  EXPECT_EQ(char_map::node_size() % 2, 1U);
+  // values too large for 5 per 256 bytes still get 5
+  EXPECT_EQ((s21::btree_map<int, std::array<char, 200>>::node_size()), 5U);
+  EXPECT_EQ((s21::btree_map<int, int, 7>::node_size()), 7U);
+}
+
+TEST(BtreeMap, ElementAccess) {
+  s21::btree_map<int, std::string> my_map = {{2, "b"}, {1, "a"}, {3, "c"}};
+  EXPECT_EQ(my_map.at(2), "b");
+  EXPECT_THROW((void)my_map.at(4), std::out_of_range);
+  const auto &const_map = my_map;
+  EXPECT_EQ(const_map.at(1), "a");
+  EXPECT_THROW((void)const_map.at(0), std::out_of_range);
+  my_map[4] = "d";
+  my_map[1] += "a";
+  EXPECT_EQ(my_map[1], "aa");
+  EXPECT_EQ(my_map.size(), 4U);
+  EXPECT_TRUE(my_map.contains(4));
+  EXPECT_EQ(my_map.count(5), 0U);
+}
+
+TEST(BtreeMap, InsertVariants) {
+  s21::btree_map<int, std::string> my_map;
+  EXPECT_TRUE(my_map.insert({1, "a"}).second);
+  EXPECT_FALSE(my_map.insert(1, "b").second);
+  EXPECT_EQ(my_map.at(1), "a");
+  auto assigned = my_map.insert_or_assign(1, "c");
+  EXPECT_FALSE(assigned.second);
+  EXPECT_EQ(assigned.first->second, "c");
+  EXPECT_TRUE(my_map.insert_or_assign(2, "d").second);
+  auto placed = my_map.try_emplace(3, 2, 'e');
+  EXPECT_TRUE(placed.second);
+  EXPECT_EQ(placed.first->second, "ee");
+  EXPECT_FALSE(my_map.emplace(3, "f").second);
+  EXPECT_EQ(my_map.at(3), "ee");
+  ExpectSameItems(my_map, std::map<int, std::string>{
+                              {1, "c"}, {2, "d"}, {3, "ee"}});
+}
+
+TEST(BtreeMap, RandomInsertEraseMatchesStdMap) {
+  // tiny nodes split, rotate and merge on almost every operation
+  s21::btree_map<int, int, 3> small_nodes;
+  s21::btree_map<int, int, 5> medium_nodes;
+  std::map<int, int> expected;
+  unsigned seed = 7;
+  for (int step = 0; step < 4000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 500);
+    if ((seed >> 4) % 3 == 0) {
+      size_t erased = expected.erase(key);
+      ASSERT_EQ(small_nodes.erase(key), erased);
+      ASSERT_EQ(medium_nodes.erase(key), erased);
+    } else {
+      bool inserted = expected.insert({key, step}).second;
+      ASSERT_EQ(small_nodes.insert(key, step).second, inserted);
+      ASSERT_EQ(medium_nodes.insert(key, step).second, inserted);
+    }
+    if (step % 500 == 0) {
+      ExpectSameItems(small_nodes, expected);
+      ExpectSameItems(medium_nodes, expected);
+    }
+  }
+  ExpectSameItems(small_nodes, expected);
+  ExpectSameItems(medium_nodes, expected);
+  while (!expected.empty()) {
+    auto next = small_nodes.erase(small_nodes.find(expected.begin()->first));
+    expected.erase(expected.begin());
+    if (expected.empty()) {
+      ASSERT_TRUE(next == small_nodes.end());
+    } else {
+      ASSERT_EQ(next->first, expected.begin()->first);
+    }
+  }
+  EXPECT_TRUE(small_nodes.empty());
+  EXPECT_EQ(small_nodes.height(), 0U);
+}
+
+TEST(BtreeMap, HeightStaysLogarithmic) {
+  s21::btree_map<int, int, 5> my_map;
+  for (int key = 0; key < 10000; ++key) my_map.insert(key, key);
+  // every internal node but the root holds at least 2 values, so 3
+  // children; only leaves are split off-center
+  EXPECT_LE(my_map.height(), 9U);
+  for (int key = 0; key < 10000; key += 2) my_map.erase(key);
+  EXPECT_LE(my_map.height(), 8U);
+  EXPECT_EQ(my_map.size(), 5000U);
+  EXPECT_EQ(my_map.begin()->first, 1);
+}
+
+TEST(BtreeMap, EraseFromShortEdgeOfSortedRun) {
+  // ascending inserts leave a short last leaf, descending ones a short
+  // first leaf; erasing from that side must rebalance the underfull leaf
+  for (bool ascending : {true, false}) {
+    s21::btree_map<int, int, 7> my_map;
+    std::map<int, int> expected;
+    for (int i = 0; i < 2000; ++i) {
+      int key = ascending ? i : 2000 - i;
+      my_map.insert(key, key);
+      expected[key] = key;
+    }
+    for (int i = 0; i < 1990; ++i) {
+      auto edge = ascending ? std::prev(expected.end()) : expected.begin();
+      ASSERT_EQ(my_map.erase(edge->first), 1U);
+      expected.erase(edge);
+      if (i % 97 == 0) ExpectSameItems(my_map, expected);
+    }
+    ExpectSameItems(my_map, expected);
+    EXPECT_LE(my_map.height(), 2U);
+  }
+}
+
+TEST(BtreeMap, Bounds) {
+  s21::btree_map<int, int, 3> my_map;
+  for (int key = 0; key < 100; key += 10) my_map.insert(key, key);
+  EXPECT_EQ(my_map.lower_bound(30)->first, 30);
+  EXPECT_EQ(my_map.lower_bound(31)->first, 40);
+  EXPECT_EQ(my_map.upper_bound(30)->first, 40);
+  EXPECT_TRUE(my_map.lower_bound(91) == my_map.end());
+  EXPECT_TRUE(my_map.upper_bound(90) == my_map.end());
+  EXPECT_EQ(my_map.lower_bound(-5)->first, 0);
+  auto range = my_map.equal_range(50);
+  EXPECT_EQ(range.first->first, 50);
+  EXPECT_EQ(range.second->first, 60);
+  auto missing = my_map.equal_range(55);
+  EXPECT_TRUE(missing.first == missing.second);
+  EXPECT_TRUE(my_map.find(55) == my_map.end());
+}
+
+TEST(BtreeMap, CustomCompare) {
+  s21::btree_map<int, int, 3, std::greater<int>> my_map;
+  for (int key = 0; key < 20; ++key) my_map[key] = key;
+  int expected = 19;
+  for (const auto &item : my_map) EXPECT_EQ(item.first, expected--);
+  EXPECT_EQ(my_map.lower_bound(10)->first, 10);
+  EXPECT_EQ(my_map.upper_bound(10)->first, 9);
+}
+
+TEST(BtreeMap, CopyMoveAndSwap) {
+  s21::btree_map<int, std::string, 3> my_map;
+  std::map<int, std::string> expected;
+  for (int key = 0; key < 200; ++key) {
+    my_map[key * 7 % 200] = std::to_string(key);
+    expected[key * 7 % 200] = std::to_string(key);
+  }
+  s21::btree_map<int, std::string, 3> copy(my_map);
+  ExpectSameItems(copy, expected);
+  EXPECT_EQ(copy.height(), my_map.height());
+  s21::btree_map<int, std::string, 3> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  ExpectSameItems(moved, expected);
+  s21::btree_map<int, std::string, 3> assigned = {{1000, "x"}};
+  assigned = my_map;
+  ExpectSameItems(assigned, expected);
+  s21::btree_map<int, std::string, 3> other = {{-1, "y"}};
+  other.swap(assigned);
+  ExpectSameItems(other, expected);
+  EXPECT_EQ(assigned.size(), 1U);
+  assigned = std::move(other);
+  ExpectSameItems(assigned, expected);
+}
+
+TEST(BtreeMap, MergeMovesMissingKeys) {
+  s21::btree_map<int, std::string> my_map = {{1, "a"}, {3, "c"}};
+  s21::btree_map<int, std::string> other = {{2, "b"}, {3, "x"}, {4, "d"}};
+  my_map.merge(other);
+  ExpectSameItems(my_map, std::map<int, std::string>{
+                              {1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}});
+  ExpectSameItems(other, std::map<int, std::string>{{3, "x"}});
+}
+
+TEST(BtreeMap, AllocatorOwnsNodes) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  Alloc alloc;
+  {
+    s21::btree_map<int, int, 3, std::less<int>, Alloc> my_map(alloc);
+    for (int key = 0; key < 100; ++key) my_map.insert(key, key);
+    EXPECT_GT(alloc.stats()->live_objects, 0U);
+    auto copy = my_map;
+    for (int key = 0; key < 100; key += 3) copy.erase(key);
+    copy.clear();
+    for (int key = 0; key < 50; ++key) my_map.erase(key);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+  EXPECT_EQ(alloc.stats()->allocations, alloc.stats()->deallocations);
+}
+
+TEST(BtreeMap, FailedCopyReleasesNodes) {
+  struct Fragile {
+    int value = 0;
+    Fragile(int v) : value(v) {}
+    Fragile(const Fragile &other) : value(other.value) {
+      if (value == 150) throw std::runtime_error("copy failed");
+    }
+    Fragile(Fragile &&other) noexcept = default;
+  };
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, Fragile>>;
+  Alloc alloc;
+  {
+    s21::btree_map<int, Fragile, 3, std::less<int>, Alloc> my_map(alloc);
+    for (int key = 0; key < 200; ++key) my_map.try_emplace(key, key);
+    size_t live = alloc.stats()->live_objects;
+    using FragileMap = s21::btree_map<int, Fragile, 3, std::less<int>, Alloc>;
+    EXPECT_THROW(FragileMap copy(my_map), std::runtime_error);
+    EXPECT_EQ(alloc.stats()->live_objects, live);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+}
+
+TEST(BtreeMap, LookupBenchmark) {
+  const int kKeys = 200000;
+  std::vector<int> random_keys = RandomKeys(kKeys, 12345);
+  std::vector<int> sequential_keys(kKeys);
+  for (int i = 0; i < kKeys; ++i) sequential_keys[i] = i;
+  auto ns = [kKeys](auto duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+               .count() /
+           kKeys;
+  };
+  for (const auto *keys : {&random_keys, &sequential_keys}) {
+    const char *order = keys == &random_keys ? "random" : "sequential";
+    using Pair = std::pair<const int, int>;
+    s21_test::CountingAllocator<Pair> tree_alloc, btree_alloc;
+    s21::map<int, int, std::less<int>, s21_test::CountingAllocator<Pair>>
+        tree_map(tree_alloc);
+    s21::btree_map<int, int, 0, std::less<int>,
+                   s21_test::CountingAllocator<Pair>>
+        btree_map(btree_alloc);
+    auto start = std::chrono::steady_clock::now();
+    for (int key : *keys) tree_map.insert(key, key);
+    auto tree_inserted = std::chrono::steady_clock::now();
+    long tree_sum = 0;
+    for (int key : *keys) tree_sum += tree_map.find(key)->second;
+    auto tree_found = std::chrono::steady_clock::now();
+    for (int key : *keys) btree_map.insert(key, key);
+    auto btree_inserted = std::chrono::steady_clock::now();
+    long btree_sum = 0;
+    for (int key : *keys) btree_sum += btree_map.find(key)->second;
+    auto btree_found = std::chrono::steady_clock::now();
+    ASSERT_EQ(tree_sum, btree_sum);
+    ASSERT_EQ(tree_map.size(), btree_map.size());
+    size_t tree_bytes = tree_alloc.stats()->live_bytes / tree_map.size();
+    size_t btree_bytes = btree_alloc.stats()->live_bytes / btree_map.size();
+    std::cout << "[ BENCH    ] " << kKeys << " " << order
+              << " keys, s21::map: " << ns(tree_inserted - start)
+              << " ns/insert, " << ns(tree_found - tree_inserted)
+              << " ns/find, " << tree_bytes << " bytes/entry; btree_map: "
+              << ns(btree_inserted - tree_found) << " ns/insert, "
+              << ns(btree_found - btree_inserted) << " ns/find, "
+              << btree_bytes << " bytes/entry, height " << btree_map.height()
+              << std::endl;
+    EXPECT_LT(btree_bytes * 2, tree_bytes);
+    EXPECT_LE(btree_map.height(), 5U);
+  }
+}
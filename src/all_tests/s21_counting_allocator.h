@@ -0,0 +1,74 @@
+#ifndef CPP2_S21_CONTAINERS_1_ALL_TESTS_COUNTING_ALLOCATOR_H
+#define CPP2_S21_CONTAINERS_1_ALL_TESTS_COUNTING_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace s21_test {
+
+/* Counters shared by every copy and rebind of one CountingAllocator */
+struct AllocationStats {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t live_objects = 0;
+  std::size_t live_bytes = 0;
+};
+
+/* Stateful allocator used to check that containers route all of their
+ * memory through the allocator they were given. Allocators compare equal
+ * only when they share the same statistics. */
+template <typename T>
+class CountingAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  CountingAllocator() : stats_(std::make_shared<AllocationStats>()) {}
+  explicit CountingAllocator(std::shared_ptr<AllocationStats> stats)
+      : stats_(std::move(stats)) {}
+  /* Allocators must stay unchanged when moved from, so moves copy */
+  CountingAllocator(const CountingAllocator &other) noexcept = default;
+  CountingAllocator &operator=(const CountingAllocator &other) noexcept =
+      default;
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &other) noexcept
+      : stats_(other.stats()) {}
+
+  T *allocate(std::size_t n) {
+    ++stats_->allocations;
+    stats_->live_objects += n;
+    stats_->live_bytes += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    ++stats_->deallocations;
+    stats_->live_objects -= n;
+    stats_->live_bytes -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  const std::shared_ptr<AllocationStats> &stats() const noexcept {
+    return stats_;
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U> &other) const noexcept {
+    return stats_ == other.stats();
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U> &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<AllocationStats> stats_;
+};
+
+}  // namespace s21_test
+
+#endif  // CPP2_S21_CONTAINERS_1_ALL_TESTS_COUNTING_ALLOCATOR_H
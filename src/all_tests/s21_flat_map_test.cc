@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+#include "s21_tree_probe.h"
+
+namespace {
+
+template <typename Map, typename Expected>
+void ExpectSameItems(const Map &my_map, const Expected &expected) {
+  ASSERT_EQ(my_map.size(), expected.size());
+  auto my_it = my_map.begin();
+  for (const auto &item : expected) {
+    ASSERT_TRUE(my_it != my_map.end());
+    ASSERT_EQ(my_it->first, item.first);
+    ASSERT_EQ(my_it->second, item.second);
+    ++my_it;
+  }
+  ASSERT_TRUE(my_it == my_map.end());
+}
+
+}  // namespace
+
+TEST(FlatMap, DefaultConstructor) {
+  s21::flat_map<int, int> my_map;
+  EXPECT_TRUE(my_map.empty());
+  EXPECT_EQ(my_map.size(), 0U);
+  EXPECT_TRUE(my_map.begin() == my_map.end());
+  EXPECT_FALSE(my_map.contains(0));
+  EXPECT_TRUE(my_map.find(0) == my_map.end());
+  EXPECT_EQ(my_map.erase(0), 0U);
+}
+
+TEST(FlatMap, UnsortedInputIsSortedOnce) {
+  s21::flat_map<int, std::string> my_map = {
+      {3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}, {3, "y"}};
+  // the first of repeated keys wins, as with repeated map::insert
+  ExpectSameItems(my_map,
+                  std::map<int, std::string>{{1, "a"}, {2, "b"}, {3, "c"}});
+  EXPECT_EQ(my_map.keys().size(), 3U);
+  EXPECT_EQ(my_map.values()[1], "b");
+}
+
+TEST(FlatMap, ElementAccess) {
+  s21::flat_map<int, std::string> my_map = {{2, "b"}, {1, "a"}};
+  EXPECT_EQ(my_map.at(2), "b");
+  EXPECT_THROW((void)my_map.at(3), std::out_of_range);
+  const auto &const_map = my_map;
+  EXPECT_EQ(const_map.at(1), "a");
+  EXPECT_THROW((void)const_map.at(0), std::out_of_range);
+  my_map[0] = "z";
+  my_map[2] += "b";
+  ExpectSameItems(my_map,
+                  std::map<int, std::string>{{0, "z"}, {1, "a"}, {2, "bb"}});
+}
+
+TEST(FlatMap, InsertVariants) {
+  s21::flat_map<int, std::string> my_map;
+  EXPECT_TRUE(my_map.insert({5, "e"}).second);
+  EXPECT_FALSE(my_map.insert(5, "f").second);
+  auto assigned = my_map.insert_or_assign(5, "g");
+  EXPECT_FALSE(assigned.second);
+  EXPECT_EQ(assigned.first->second, "g");
+  EXPECT_TRUE(my_map.insert_or_assign(1, "a").second);
+  auto placed = my_map.try_emplace(3, 2, 'c');
+  EXPECT_TRUE(placed.second);
+  EXPECT_EQ((*placed.first).second, "cc");
+  EXPECT_FALSE(my_map.emplace(3, "d").second);
+  ExpectSameItems(my_map,
+                  std::map<int, std::string>{{1, "a"}, {3, "cc"}, {5, "g"}});
+}
+
+TEST(FlatMap, RangeInsertKeepsStoredValues) {
+  s21::flat_map<int, int> my_map = {{10, 1}, {30, 3}};
+  std::vector<std::pair<int, int>> more = {{40, 4}, {20, 2}, {10, 9}, {20, 8}};
+  my_map.insert(more.begin(), more.end());
+  ExpectSameItems(my_map,
+                  std::map<int, int>{{10, 1}, {20, 2}, {30, 3}, {40, 4}});
+  std::map<int, int> source = {{5, 5}, {25, 25}};
+  s21::flat_map<int, int> from_map(source.begin(), source.end());
+  ExpectSameItems(from_map, source);
+}
+
+TEST(FlatMap, EraseAndIterators) {
+  s21::flat_map<int, int> my_map = {{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+  auto next = my_map.erase(my_map.find(2));
+  EXPECT_EQ(next->first, 3);
+  EXPECT_EQ(my_map.erase(4), 1U);
+  auto past_last = my_map.erase(my_map.find(3));
+  EXPECT_TRUE(past_last == my_map.end());
+  ExpectSameItems(my_map, std::map<int, int>{{1, 1}});
+  s21::flat_map<int, int> numbers = {{1, 10}, {2, 20}, {3, 30}};
+  for (auto it = numbers.begin(); it != numbers.end(); ++it) it->second += 1;
+  auto last = numbers.end();
+  EXPECT_EQ((--last)->second, 31);
+  EXPECT_EQ(numbers.end() - numbers.begin(), 3);
+  EXPECT_EQ(numbers.begin()[1].second, 21);
+  s21::flat_map<int, int>::const_iterator first = numbers.begin();
+  EXPECT_TRUE(first == numbers.begin());
+}
+
+TEST(FlatMap, Bounds) {
+  s21::flat_map<int, int> my_map;
+  for (int key = 0; key < 100; key += 10) my_map[key] = key;
+  EXPECT_EQ(my_map.lower_bound(30)->first, 30);
+  EXPECT_EQ(my_map.lower_bound(31)->first, 40);
+  EXPECT_EQ(my_map.upper_bound(30)->first, 40);
+  EXPECT_TRUE(my_map.lower_bound(91) == my_map.end());
+  EXPECT_TRUE(my_map.upper_bound(90) == my_map.end());
+  EXPECT_EQ(my_map.upper_bound(-1)->first, 0);
+  auto range = my_map.equal_range(50);
+  EXPECT_EQ(range.second - range.first, 1);
+  auto missing = my_map.equal_range(55);
+  EXPECT_TRUE(missing.first == missing.second);
+  EXPECT_EQ(missing.first->first, 60);
+}
+
+TEST(FlatMap, BranchlessSearchMatchesStdLowerBound) {
+  for (int count = 0; count < 70; ++count) {
+    s21::flat_map<int, int> my_map;
+    std::map<int, int> expected;
+    for (int key = 0; key < count; ++key) {
+      my_map[key * 2] = key;
+      expected[key * 2] = key;
+    }
+    for (int key = -1; key <= count * 2; ++key) {
+      auto lower = expected.lower_bound(key);
+      auto upper = expected.upper_bound(key);
+      ASSERT_EQ(my_map.lower_bound(key) == my_map.end(),
+                lower == expected.end());
+      if (lower != expected.end()) {
+        ASSERT_EQ(my_map.lower_bound(key)->first, lower->first);
+      }
+      if (upper != expected.end()) {
+        ASSERT_EQ(my_map.upper_bound(key)->first, upper->first);
+      }
+      ASSERT_EQ(my_map.contains(key), expected.count(key) == 1);
+    }
+  }
+}
+
+TEST(FlatMap, CustomCompareAndStringKeys) {
+  s21::flat_map<std::string, int, std::greater<std::string>> my_map = {
+      {"b", 2}, {"a", 1}, {"c", 3}};
+  EXPECT_EQ(my_map.begin()->first, "c");
+  EXPECT_EQ(my_map.lower_bound("bb")->first, "b");
+  EXPECT_EQ(my_map.at("a"), 1);
+}
+
+TEST(FlatMap, TransparentLookup) {
+  s21::flat_map<std::string, int, std::less<>> my_map = {
+      {"apple", 1}, {"kiwi", 2}, {"pear", 3}};
+  std::string_view kiwi = "kiwi";
+  EXPECT_EQ(my_map.find(kiwi)->second, 2);
+  const auto &const_map = my_map;
+  EXPECT_EQ(const_map.find(std::string_view("pear"))->second, 3);
+  EXPECT_TRUE(my_map.contains(std::string_view("apple")));
+  EXPECT_EQ(my_map.count(std::string_view("plum")), 0U);
+  EXPECT_EQ(my_map.lower_bound(std::string_view("b"))->first, "kiwi");
+  EXPECT_EQ(const_map.upper_bound(kiwi)->first, "pear");
+  auto range = const_map.equal_range(kiwi);
+  EXPECT_EQ(range.second - range.first, 1);
+}
+
+TEST(FlatMap, MergeAndSwap) {
+  s21::flat_map<int, std::string> my_map = {{1, "a"}, {3, "c"}};
+  s21::flat_map<int, std::string> other = {{2, "b"}, {3, "x"}, {4, "d"}};
+  my_map.merge(other);
+  ExpectSameItems(my_map, std::map<int, std::string>{
+                              {1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}});
+  ExpectSameItems(other, std::map<int, std::string>{{3, "x"}});
+  other.swap(my_map);
+  EXPECT_EQ(my_map.size(), 1U);
+  EXPECT_EQ(other.size(), 4U);
+  s21::flat_map<int, std::string> copy = other;
+  ExpectSameItems(copy, std::map<int, std::string>{
+                            {1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}});
+}
+
+TEST(FlatMap, AllocatorOwnsArrays) {
+  using Alloc = s21_test::CountingAllocator<std::pair<int, int>>;
+  Alloc alloc;
+  {
+    s21::flat_map<int, int, std::less<int>, Alloc> my_map(alloc);
+    for (int key = 0; key < 100; ++key) my_map[key] = key;
+    EXPECT_GT(alloc.stats()->live_objects, 0U);
+    EXPECT_TRUE(my_map.get_allocator() == alloc);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+}
+
+TEST(FlatMap, LookupBenchmark) {
+  const int kKeys = 200000;
+  std::vector<std::pair<int, int>> items(kKeys);
+  unsigned seed = 12345;
+  for (int i = 0; i < kKeys; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    items[i] = {static_cast<int>(seed >> 1), i};
+  }
+  auto start = std::chrono::steady_clock::now();
+  s21::flat_map<int, int> flat(items.begin(), items.end());
+  auto built = std::chrono::steady_clock::now();
+  s21::map<int, int> tree_map;
+  for (const auto &item : items) tree_map.insert(item.first, item.second);
+  auto tree_built = std::chrono::steady_clock::now();
+  long flat_sum = 0;
+  for (const auto &item : items) flat_sum += flat.find(item.first)->second;
+  auto flat_found = std::chrono::steady_clock::now();
+  long tree_sum = 0;
+  for (const auto &item : items) tree_sum += tree_map.find(item.first)->second;
+  auto tree_found = std::chrono::steady_clock::now();
+  ASSERT_EQ(flat.size(), tree_map.size());
+  ASSERT_EQ(flat_sum, tree_sum);
+  auto ns = [kKeys](auto duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+               .count() /
+           kKeys;
+  };
+  std::cout << "[ BENCH    ] " << kKeys << " random keys, build: flat_map "
+            << ns(built - start) << " ns/key, s21::map "
+            << ns(tree_built - built) << " ns/key; find: flat_map "
+            << ns(flat_found - tree_built) << " ns, s21::map "
+            << ns(tree_found - flat_found) << " ns" << std::endl;
+
+  // the branchless search compares exactly ceil(log2 n) + 1 times
+  size_t calls = 0;
+  s21::flat_map<int, int, s21_test::CountingLess> counted(
+      items.begin(), items.end(), s21_test::CountingLess{&calls});
+  size_t bound = static_cast<size_t>(std::ceil(std::log2(counted.size()))) + 2;
+  for (int i = 0; i < 1000; ++i) {
+    calls = 0;
+    ASSERT_TRUE(counted.contains(items[i].first));
+    ASSERT_LE(calls, bound);  // plus one to confirm the match
+  }
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+template <typename Set, typename Expected>
+void ExpectSameKeys(const Set &my_set, const Expected &expected) {
+  ASSERT_EQ(my_set.size(), expected.size());
+  auto my_it = my_set.begin();
+  for (const auto &key : expected) {
+    ASSERT_EQ(*my_it, key);
+    ++my_it;
+  }
+  ASSERT_TRUE(my_it == my_set.end());
+}
+
+/* Key built implicitly from int that counts those conversions */
+struct Converted {
+  static int conversions;
+  int value;
+  Converted(int v) : value(v) { ++conversions; }
+  bool operator<(const Converted &other) const { return value < other.value; }
+};
+int Converted::conversions = 0;
+
+template <typename Set, typename = void>
+struct HasTwoArgInsert : std::false_type {};
+template <typename Set>
+struct HasTwoArgInsert<Set, std::void_t<decltype(std::declval<Set &>().insert(
+                                1, 2))>> : std::true_type {};
+
+}  // namespace
+
+TEST(FlatSet, DefaultConstructor) {
+  s21::flat_set<int> my_set;
+  EXPECT_TRUE(my_set.empty());
+  EXPECT_TRUE(my_set.begin() == my_set.end());
+  EXPECT_FALSE(my_set.contains(1));
+  EXPECT_THROW(my_set.erase(my_set.end()), std::out_of_range);
+}
+
+TEST(FlatSet, UnsortedInputIsSortedAndDeduplicated) {
+  s21::flat_set<int> my_set = {5, 1, 4, 1, 5, 9, 2, 6};
+  ExpectSameKeys(my_set, std::set<int>{1, 2, 4, 5, 6, 9});
+  std::vector<std::string> words = {"pear", "apple", "fig", "apple"};
+  s21::flat_set<std::string> word_set(words.begin(), words.end());
+  ExpectSameKeys(word_set, std::set<std::string>{"apple", "fig", "pear"});
+  std::vector<int> sorted = {1, 1, 2, 3, 3};
+  auto adopted = s21::flat_set<int>::from_sorted(sorted.begin(), sorted.end());
+  ExpectSameKeys(adopted, std::set<int>{1, 2, 3});
+}
+
+TEST(FlatSet, InsertEraseAndLookup) {
+  s21::flat_set<int> my_set;
+  std::set<int> expected;
+  unsigned seed = 3;
+  for (int step = 0; step < 2000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 300);
+    if ((seed >> 4) % 3 == 0) {
+      ASSERT_EQ(my_set.erase(key), expected.erase(key));
+    } else {
+      auto result = my_set.insert(key);
+      ASSERT_EQ(result.second, expected.insert(key).second);
+      ASSERT_EQ(*result.first, key);
+    }
+  }
+  ExpectSameKeys(my_set, expected);
+  for (int key = -1; key <= 300; ++key) {
+    ASSERT_EQ(my_set.count(key), expected.count(key));
+    auto lower = expected.lower_bound(key);
+    auto upper = expected.upper_bound(key);
+    if (lower != expected.end()) {
+      ASSERT_EQ(*my_set.lower_bound(key), *lower);
+    }
+    if (upper != expected.end()) {
+      ASSERT_EQ(*my_set.upper_bound(key), *upper);
+    }
+    auto range = my_set.equal_range(key);
+    ASSERT_EQ(static_cast<size_t>(range.second - range.first),
+              expected.count(key));
+  }
+}
+
+TEST(FlatSet, RangeInsertMergesOnce) {
+  s21::flat_set<int> my_set = {10, 30};
+  std::vector<int> more = {40, 20, 10, 20, 5};
+  my_set.insert(more.begin(), more.end());
+  ExpectSameKeys(my_set, std::set<int>{5, 10, 20, 30, 40});
+  EXPECT_EQ(my_set.keys().size(), 5U);
+}
+
+TEST(FlatSet, EraseReturnsNext) {
+  s21::flat_set<int> my_set = {1, 2, 3};
+  auto next = my_set.erase(my_set.find(2));
+  EXPECT_EQ(*next, 3);
+  auto past_last = my_set.erase(next);
+  EXPECT_TRUE(past_last == my_set.end());
+  ExpectSameKeys(my_set, std::set<int>{1});
+}
+
+TEST(FlatSet, MergeLeavesDuplicates) {
+  s21::flat_set<int> my_set = {1, 3, 5};
+  s21::flat_set<int> other = {2, 3, 4, 5, 6};
+  my_set.merge(other);
+  ExpectSameKeys(my_set, std::set<int>{1, 2, 3, 4, 5, 6});
+  ExpectSameKeys(other, std::set<int>{3, 5});
+  other.swap(my_set);
+  EXPECT_EQ(my_set.size(), 2U);
+}
+
+TEST(FlatSet, CustomCompare) {
+  s21::flat_set<int, std::greater<int>> my_set = {1, 3, 2};
+  ExpectSameKeys(my_set, std::vector<int>{3, 2, 1});
+  EXPECT_EQ(*my_set.lower_bound(2), 2);
+  EXPECT_EQ(*my_set.upper_bound(2), 1);
+}
+
+TEST(FlatSet, LookupConvertsKeyOnce) {
+  std::vector<Converted> keys;
+  for (int i = 0; i < 1000; ++i) keys.emplace_back(i);
+  s21::flat_set<Converted> my_set(keys.begin(), keys.end());
+  // std::less<Converted> is not transparent, so the int is converted once
+  // per call instead of once per probe
+  Converted::conversions = 0;
+  EXPECT_EQ(my_set.find(500)->value, 500);
+  EXPECT_TRUE(my_set.contains(999));
+  EXPECT_EQ(my_set.count(1000), 0U);
+  EXPECT_EQ(my_set.lower_bound(10)->value, 10);
+  EXPECT_EQ(my_set.upper_bound(10)->value, 11);
+  EXPECT_EQ(my_set.equal_range(20).first->value, 20);
+  EXPECT_EQ(my_set.erase(30), 1U);
+  EXPECT_EQ(Converted::conversions, 7);
+  EXPECT_FALSE(HasTwoArgInsert<s21::flat_set<int>>::value);
+}
+
+TEST(FlatSet, TransparentLookup) {
+  s21::flat_set<std::string, std::less<>> my_set = {"apple", "kiwi", "pear"};
+  std::string_view kiwi = "kiwi";
+  EXPECT_EQ(*my_set.find(kiwi), "kiwi");
+  EXPECT_TRUE(my_set.contains(std::string_view("pear")));
+  EXPECT_EQ(my_set.count(std::string_view("plum")), 0U);
+  EXPECT_EQ(*my_set.lower_bound(std::string_view("b")), "kiwi");
+  EXPECT_EQ(*my_set.upper_bound(kiwi), "pear");
+  auto range = my_set.equal_range(kiwi);
+  EXPECT_EQ(range.second - range.first, 1);
+}
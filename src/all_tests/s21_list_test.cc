@@ -2,7 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
 #include "list"
+#include "s21_counting_allocator.h"
 
 #define s21_EPS 1e-7
 
@@ -1082,3 +1087,238 @@ TEST(ListModifiers, SpliceEmpty) {
   ASSERT_EQ(lst_other.size(), std_other.size());
   ASSERT_EQ(lst_other.size(), 0U);
 }
+
+template <typename ListType>
+void ExpectListEquals(const ListType &lst,
+                      std::initializer_list<int> expected) {
+  ASSERT_EQ(lst.size(), expected.size());
+  auto it = lst.begin();
+  for (int value : expected) {
+    EXPECT_EQ(*it, value);
+    ++it;
+  }
+}
+
+TEST(ListModifiers, SpliceSingleNode) {
+  s21::List<int> lst{1, 2, 3};
+  s21::List<int> lst_other{10, 20, 30};
+  auto it = lst_other.begin();
+  ++it;
+  lst.splice(++lst.begin(), lst_other, it);
+  ExpectListEquals(lst, {1, 20, 2, 3});
+  ExpectListEquals(lst_other, {10, 30});
+
+  lst.splice(lst.end(), lst, lst.begin());
+  ExpectListEquals(lst, {20, 2, 3, 1});
+  lst.splice(lst.begin(), lst, lst.begin());
+  ExpectListEquals(lst, {20, 2, 3, 1});
+}
+
+TEST(ListModifiers, SpliceRange) {
+  s21::List<int> lst{1, 2};
+  s21::List<int> lst_other{10, 20, 30, 40};
+  auto first = ++lst_other.begin();
+  auto last = --lst_other.end();
+  lst.splice(++lst.begin(), lst_other, first, last);
+  ExpectListEquals(lst, {1, 20, 30, 2});
+  ExpectListEquals(lst_other, {10, 40});
+
+  lst.splice(lst.begin(), lst, ++lst.begin(), lst.end());
+  ExpectListEquals(lst, {20, 30, 2, 1});
+  lst.splice(lst.end(), lst_other, lst_other.begin(), lst_other.begin());
+  ExpectListEquals(lst_other, {10, 40});
+}
+
+TEST(ListModifiers, MergeWithComparator) {
+  s21::List<int> lst{9, 5, 1};
+  s21::List<int> lst_other{10, 8, 5, 0};
+  lst.merge(lst_other, std::greater<int>());
+  ExpectListEquals(lst, {10, 9, 8, 5, 5, 1, 0});
+  EXPECT_TRUE(lst_other.empty());
+}
+
+TEST(ListModifiers, MergeIsStable) {
+  using Item = std::pair<int, char>;
+  auto by_key = [](const Item &a, const Item &b) { return a.first < b.first; };
+  s21::List<Item> lst{{1, 'a'}, {2, 'a'}, {2, 'b'}};
+  s21::List<Item> lst_other{{1, 'x'}, {2, 'x'}, {3, 'x'}};
+  lst.merge(lst_other, by_key);
+  std::list<Item> expected{{1, 'a'}, {1, 'x'}, {2, 'a'},
+                           {2, 'b'}, {2, 'x'}, {3, 'x'}};
+  ASSERT_EQ(lst.size(), expected.size());
+  auto it = lst.begin();
+  for (const Item &item : expected) {
+    EXPECT_EQ(*it, item);
+    ++it;
+  }
+}
+
+TEST(ListModifiers, SpliceAndMergeRelinkNodes) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  Alloc alloc;
+  auto stats = alloc.stats();
+  s21::List<int, Alloc> lst({1, 3, 5, 7}, alloc);
+  s21::List<int, Alloc> lst_other({0, 2, 4, 6, 8}, alloc);
+  s21::List<int, Alloc> lst_tail({9, 10}, alloc);
+  const int *address = &lst_other.front();
+  size_t allocations = stats->allocations;
+
+  lst.merge(lst_other);
+  lst.splice(lst.end(), lst_tail);
+  lst.splice(lst.begin(), lst, --lst.end());
+  EXPECT_EQ(stats->allocations, allocations);
+  EXPECT_EQ(stats->deallocations, 0U);
+  EXPECT_EQ(&*(++lst.begin()), address);
+  ExpectListEquals(lst, {10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+TEST(ListModifiers, SpliceBetweenUnequalAllocators) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  Alloc first_alloc;
+  Alloc second_alloc;
+  s21::List<int, Alloc> lst({1, 4}, first_alloc);
+  s21::List<int, Alloc> lst_other({2, 3, 5}, second_alloc);
+  lst.splice(++lst.begin(), lst_other, lst_other.begin(), --lst_other.end());
+  ExpectListEquals(lst, {1, 2, 3, 4});
+  lst.merge(lst_other);
+  ExpectListEquals(lst, {1, 2, 3, 4, 5});
+  EXPECT_EQ(first_alloc.stats()->live_objects, 5U);
+  EXPECT_EQ(second_alloc.stats()->live_objects, 0U);
+}
+
+TEST(ListModifiers, SortWithComparator) {
+  s21::List<int> lst{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+  lst.sort(std::greater<int>());
+  ExpectListEquals(lst, {9, 6, 5, 5, 5, 4, 3, 3, 2, 1, 1});
+  EXPECT_EQ(*(--lst.end()), 1);
+}
+
+TEST(ListModifiers, SortIsStable) {
+  using Item = std::pair<int, int>;
+  s21::List<Item> lst;
+  for (int i = 0; i < 1000; ++i) lst.push_back({(i * 7919) % 13, i});
+  lst.sort([](const Item &a, const Item &b) { return a.first < b.first; });
+  ASSERT_EQ(lst.size(), 1000U);
+  auto prev = lst.begin();
+  for (auto it = ++lst.begin(); it != lst.end(); ++it, ++prev) {
+    ASSERT_LE((*prev).first, (*it).first);
+    if ((*prev).first == (*it).first) {
+      ASSERT_LT((*prev).second, (*it).second);
+    }
+  }
+}
+
+TEST(ListModifiers, SortKeepsNodesWhenComparatorThrows) {
+  s21::List<int> lst{5, 4, 3, 2, 1, 0, 9, 8};
+  int calls = 0;
+  auto comp = [&calls](int a, int b) {
+    if (++calls == 6) throw std::runtime_error("comparator");
+    return a < b;
+  };
+  EXPECT_THROW(lst.sort(comp), std::runtime_error);
+  ASSERT_EQ(lst.size(), 8U);
+  int sum = 0;
+  size_t forward = 0;
+  for (auto it = lst.begin(); it != lst.end(); ++it, ++forward) sum += *it;
+  size_t backward = 0;
+  for (auto it = --lst.end(); it != lst.end(); --it) ++backward;
+  EXPECT_EQ(sum, 32);
+  EXPECT_EQ(forward, 8U);
+  EXPECT_EQ(backward, 8U);
+}
+
+/* The recursive copy-and-merge sort s21::List used before */
+template <typename ListType>
+void CopyingMergeSort(ListType &lst) {
+  if (lst.size() < 2) return;
+  ListType left(lst.get_allocator());
+  ListType right(lst.get_allocator());
+  size_t middle = lst.size() / 2;
+  auto it = lst.begin();
+  for (size_t i = 0; i < middle; ++i, ++it) left.push_back(*it);
+  for (; it != lst.end(); ++it) right.push_back(*it);
+  CopyingMergeSort(left);
+  CopyingMergeSort(right);
+  lst.clear();
+  auto left_it = left.begin();
+  auto right_it = right.begin();
+  while (left_it != left.end() && right_it != right.end()) {
+    if (*right_it < *left_it) {
+      lst.push_back(*right_it);
+      ++right_it;
+    } else {
+      lst.push_back(*left_it);
+      ++left_it;
+    }
+  }
+  for (; left_it != left.end(); ++left_it) lst.push_back(*left_it);
+  for (; right_it != right.end(); ++right_it) lst.push_back(*right_it);
+}
+
+TEST(ListModifiers, SortBenchmark) {
+  using Alloc = s21_test::CountingAllocator<std::string>;
+  const int kElements = 20000;
+  s21::List<std::string, Alloc> relinked;
+  unsigned seed = 12345;
+  for (int i = 0; i < kElements; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    relinked.push_back("key-" + std::to_string(seed % 1000003U));
+  }
+  s21::List<std::string, Alloc> copied;
+  for (const std::string &value : relinked) copied.push_back(value);
+  auto stats = relinked.get_allocator().stats();
+  size_t allocations = stats->allocations;
+
+  auto start = std::chrono::steady_clock::now();
+  CopyingMergeSort(copied);
+  auto middle = std::chrono::steady_clock::now();
+  relinked.sort();
+  auto stop = std::chrono::steady_clock::now();
+
+  size_t copy_allocations = copied.get_allocator().stats()->allocations;
+  std::cout << "[ BENCH    ] sort of " << kElements << " strings: copying "
+            << copy_allocations << " node allocations "
+            << std::chrono::duration_cast<std::chrono::microseconds>(middle -
+                                                                     start)
+                   .count()
+            << " us, in-place "
+            << stats->allocations - allocations << " node allocations "
+            << std::chrono::duration_cast<std::chrono::microseconds>(stop -
+                                                                     middle)
+                   .count()
+            << " us" << std::endl;
+  EXPECT_EQ(stats->allocations, allocations);
+  EXPECT_GT(copy_allocations, static_cast<size_t>(kElements) * 10);
+  auto it = copied.begin();
+  for (const std::string &value : relinked) {
+    ASSERT_EQ(value, *it);
+    ++it;
+  }
+}
+
+TEST(ListAllocator, AllocatesOneNodePerElement) {
+  s21_test::CountingAllocator<int> alloc;
+  auto stats = alloc.stats();
+  {
+    s21::List<int, s21_test::CountingAllocator<int>> list({1, 2, 3}, alloc);
+    EXPECT_EQ(stats->live_objects, 3U);
+    list.push_front(0);
+    list.pop_back();
+    EXPECT_EQ(stats->live_objects, 3U);
+    auto copy = list;
+    EXPECT_EQ(copy.get_allocator(), alloc);
+    EXPECT_EQ(stats->live_objects, 6U);
+  }
+  EXPECT_EQ(stats->allocations, stats->deallocations);
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(ListAllocator, NoDefaultConstructorRequired) {
+  struct NoDefault {
+    explicit NoDefault(int v) : value(v) {}
+    int value;
+  };
+  s21::List<NoDefault> list;
+  list.push_back(NoDefault(7));
+  EXPECT_EQ(list.front().value, 7);
+}
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "../containers/s21_map.h"
+#include "../containers/s21_multimap.h"
+#include "s21_counting_allocator.h"
+#include "s21_tree_probe.h"
 
 TEST(MapTest, BasicConstructor) {
   s21::map<int, int> test;
@@ -489,3 +497,346 @@ TEST(MapTest, Emplace) {
   }
   ASSERT_TRUE(my_iter == my_map.end());
 }
+
+TEST(MapTest, AllocatorOwnsNodes) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  Alloc alloc;
+  auto stats = alloc.stats();
+  {
+    s21::map<int, int, std::less<int>, Alloc> my_map({{1, 1}, {2, 2}, {3, 3}},
+                                                     alloc);
+    /* One node per element, the end node lives inside the map */
+    EXPECT_EQ(stats->live_objects, 3U);
+    my_map.erase(my_map.begin());
+    EXPECT_EQ(stats->live_objects, 2U);
+    s21::map<int, int, std::less<int>, Alloc> moved(std::move(my_map));
+    EXPECT_EQ(moved.get_allocator(), alloc);
+    EXPECT_EQ(moved.size(), 2U);
+  }
+  EXPECT_EQ(stats->allocations, stats->deallocations);
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(MapRedBlack, RandomInsertEraseKeepsInvariants) {
+  s21_test::RedBlackProbe<s21::map<int, int>> my_map;
+  std::map<int, int> std_map;
+  unsigned seed = 2024;
+  for (int step = 0; step < 4000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 500);
+    if ((seed >> 4) % 3 == 0) {
+      for (auto it = my_map.begin(); it != my_map.end(); ++it) {
+        if ((*it).first == key) {
+          my_map.erase(it);
+          break;
+        }
+      }
+      std_map.erase(key);
+    } else {
+      my_map.insert(key, step);
+      std_map.insert({key, step});
+    }
+    if (step % 100 == 0) {
+      ASSERT_GT(my_map.BlackHeight(), 0);
+    }
+  }
+  ASSERT_GT(my_map.BlackHeight(), 0);
+  ASSERT_EQ(my_map.size(), std_map.size());
+  auto my_it = my_map.begin();
+  for (const auto& item : std_map) {
+    ASSERT_EQ((*my_it).first, item.first);
+    ASSERT_EQ((*my_it).second, item.second);
+    ++my_it;
+  }
+  ASSERT_TRUE(my_it == my_map.end());
+}
+
+TEST(MapRedBlack, EraseKeepsOtherIterators) {
+  s21::map<int, int> my_map{{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+  auto it = my_map.begin();
+  ++it;
+  ++it;  // 3, a node with two children
+  auto next = it;
+  ++next;
+  my_map.erase(it);
+  EXPECT_EQ((*next).first, 4);
+  EXPECT_EQ((*--my_map.end()).first, 5);
+  EXPECT_EQ((*my_map.begin()).first, 1);
+}
+
+TEST(MapRedBlack, MonotonicInsertBenchmark) {
+  const int kKeys = 1000000;
+  s21_test::RedBlackProbe<s21::map<int, int>> my_map;
+  auto start = std::chrono::steady_clock::now();
+  for (int key = 0; key < kKeys; ++key) my_map.insert(key, key);
+  auto stop = std::chrono::steady_clock::now();
+  size_t height = my_map.Height();
+  std::cout << "[ BENCH    ] " << kKeys << " increasing keys into s21::map: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(stop -
+                                                                     start)
+                   .count()
+            << " ms, height " << height << std::endl;
+  EXPECT_EQ(my_map.size(), static_cast<size_t>(kKeys));
+  // a red-black tree is never deeper than 2 * log2(n + 1)
+  EXPECT_LE(height, 40U);
+  EXPECT_GT(my_map.BlackHeight(), 0);
+  EXPECT_EQ(my_map.at(kKeys / 2), kKeys / 2);
+}
+
+TEST(MapCompare, CustomOrder) {
+  s21::map<int, std::string, std::greater<int>> my_map = {
+      {1, "one"}, {3, "three"}, {2, "two"}};
+  std::map<int, std::string, std::greater<int>> std_map = {
+      {1, "one"}, {3, "three"}, {2, "two"}};
+  auto my_it = my_map.begin();
+  for (const auto& item : std_map) {
+    EXPECT_EQ((*my_it).first, item.first);
+    EXPECT_EQ((*my_it).second, item.second);
+    ++my_it;
+  }
+  EXPECT_EQ(my_map.at(2), "two");
+  EXPECT_FALSE(my_map.insert(3, "again").second);
+}
+
+TEST(MapCompare, TransparentLookup) {
+  s21::map<std::string, int, std::less<>> my_map = {
+      {"apple", 1}, {"banana", 2}, {"cherry", 3}};
+  std::string_view key = "banana";
+  auto found = my_map.find(key);
+  ASSERT_TRUE(found != my_map.end());
+  EXPECT_EQ((*found).second, 2);
+  EXPECT_TRUE(my_map.contains(std::string_view("cherry")));
+  EXPECT_FALSE(my_map.contains(std::string_view("durian")));
+  EXPECT_EQ(my_map.count(std::string_view("apple")), 1U);
+  EXPECT_TRUE(my_map.find("plum") == my_map.end());
+}
+
+TEST(MapCompare, OneComparisonPerLevel) {
+  std::size_t calls = 0;
+  s21_test::RedBlackProbe<s21::map<int, int, s21_test::CountingLess>> my_map(
+      s21_test::CountingLess{&calls});
+  for (int key = 0; key < 1023; ++key) my_map.insert(key * 2, key);
+  const std::size_t height = my_map.Height();
+  for (int key = -1; key < 2047; ++key) {
+    calls = 0;
+    my_map.find(key);
+    // one call per level plus the final equality check
+    EXPECT_LE(calls, height + 1);
+    if (key % 2 == 0) continue;
+    calls = 0;
+    EXPECT_TRUE(my_map.insert(key, key).second);
+    EXPECT_LE(calls, height + 1);
+    my_map.erase(my_map.find(key));
+  }
+  EXPECT_EQ(my_map.size(), 1023U);
+}
+
+TEST(MapInsert, InsertOrAssignReportsInsertion) {
+  s21::map<int, std::string> my_map;
+  auto inserted = my_map.insert_or_assign(1, "one");
+  EXPECT_TRUE(inserted.second);
+  auto assigned = my_map.insert_or_assign(1, "uno");
+  EXPECT_FALSE(assigned.second);
+  EXPECT_TRUE(assigned.first == inserted.first);
+  EXPECT_EQ((*assigned.first).second, "uno");
+  EXPECT_EQ(my_map.size(), 1U);
+}
+
+TEST(MapInsert, TryEmplaceKeepsArgumentsOnHit) {
+  s21::map<int, std::unique_ptr<int>> my_map;
+  auto value = std::make_unique<int>(7);
+  EXPECT_TRUE(my_map.try_emplace(1, std::move(value)).second);
+  EXPECT_EQ(value, nullptr);
+  auto other = std::make_unique<int>(8);
+  auto result = my_map.try_emplace(1, std::move(other));
+  EXPECT_FALSE(result.second);
+  ASSERT_NE(other, nullptr);  // not moved from
+  EXPECT_EQ(*(*result.first).second, 7);
+}
+
+TEST(MapInsert, SubscriptInsertsWithOneDescent) {
+  std::size_t calls = 0;
+  s21_test::RedBlackProbe<s21::map<int, int, s21_test::CountingLess>> my_map(
+      s21_test::CountingLess{&calls});
+  for (int key = 0; key < 1000; ++key) {
+    const std::size_t height = my_map.Height();
+    calls = 0;
+    my_map[key * 7 % 1000] += key;
+    // one descent plus one check of the neighbour, no second lookup
+    EXPECT_LE(calls, height + 1);
+  }
+  EXPECT_EQ(my_map.size(), 1000U);
+  calls = 0;
+  EXPECT_EQ(my_map[0], 0);
+  EXPECT_LE(calls, my_map.Height() + 1);
+  EXPECT_EQ(my_map.size(), 1000U);
+}
+
+TEST(MapInsert, FreshKeyBenchmark) {
+  const int kKeys = 200000;
+  std::vector<int> keys(kKeys);
+  unsigned seed = 12345;
+  for (int i = 0; i < kKeys; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    keys[i] = static_cast<int>(seed);
+  }
+  s21::map<int, int> my_map;
+  auto start = std::chrono::steady_clock::now();
+  for (int key : keys) ++my_map[key];
+  auto middle = std::chrono::steady_clock::now();
+  std::map<int, int> std_map;
+  for (int key : keys) ++std_map[key];
+  auto stop = std::chrono::steady_clock::now();
+  auto ns = [kKeys](auto duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+               .count() /
+           kKeys;
+  };
+  std::cout << "[ BENCH    ] operator[] on " << kKeys
+            << " fresh keys: s21::map " << ns(middle - start)
+            << " ns/insert, std::map " << ns(stop - middle) << " ns/insert"
+            << std::endl;
+  EXPECT_EQ(my_map.size(), std_map.size());
+}
+
+TEST(MapRanked, Leaderboard) {
+  s21_test::RedBlackProbe<
+      s21::map<int, std::string, std::greater<int>,
+               std::allocator<std::pair<const int, std::string>>, true>>
+      scores;
+  scores.insert(50, "ann");
+  scores.insert(80, "bob");
+  scores[65] = "cid";
+  scores.try_emplace(90, "dan");
+  scores.erase(scores.find(80));
+  ASSERT_GT(scores.BlackHeight(), 0);
+  EXPECT_EQ((*scores.nth(0)).second, "dan");
+  EXPECT_EQ((*scores.nth(1)).second, "cid");
+  EXPECT_EQ(scores.rank(60), 2U);  // scores above 60
+  EXPECT_EQ(scores.distance(scores.begin(), scores.find(50)), 2U);
+  EXPECT_TRUE(scores.nth(3) == scores.end());
+}
+
+TEST(MapBulk, FromSortedAndSnapshotBenchmark) {
+  const int kKeys = 200000;
+  std::vector<std::pair<int, int>> sorted;
+  sorted.reserve(kKeys);
+  for (int key = 0; key < kKeys; ++key) sorted.emplace_back(key * 2, key);
+  auto start = std::chrono::steady_clock::now();
+  auto bulk = s21::map<int, int>::from_sorted(sorted.begin(), sorted.end());
+  auto built = std::chrono::steady_clock::now();
+  s21::map<int, int> snapshot(bulk);
+  auto copied = std::chrono::steady_clock::now();
+  s21::map<int, int> inserted;
+  for (const auto& item : sorted) inserted.insert(item);
+  auto stop = std::chrono::steady_clock::now();
+  auto ms = [](auto duration) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+        .count();
+  };
+  std::cout << "[ BENCH    ] " << kKeys << " entries: from_sorted "
+            << ms(built - start) << " ms, copy " << ms(copied - built)
+            << " ms, insert one by one " << ms(stop - copied) << " ms"
+            << std::endl;
+  ASSERT_EQ(bulk.size(), static_cast<size_t>(kKeys));
+  ASSERT_EQ(snapshot.size(), bulk.size());
+  EXPECT_EQ(bulk.at(2 * 777), 777);
+  EXPECT_EQ(snapshot.at(2 * (kKeys - 1)), kKeys - 1);
+  EXPECT_FALSE(snapshot.contains(3));
+  s21::multimap<int, int> multi =
+      s21::multimap<int, int>::from_sorted(sorted.begin(), sorted.begin() + 3);
+  EXPECT_EQ(multi.size(), 3U);
+}
+
+TEST(MapNodeHandle, ExtractAndInsertKeepTheNode) {
+  s21::map<int, std::string> source = {{1, "one"}, {2, "two"}};
+  s21::map<int, std::string> target = {{3, "three"}};
+  const std::string* address = &source.at(2);
+  auto handle = source.extract(2);
+  ASSERT_FALSE(handle.empty());
+  EXPECT_EQ(source.size(), 1U);
+  EXPECT_EQ(handle.key(), 2);
+  handle.key() = 4;
+  handle.mapped() += "!";
+  auto result = target.insert(std::move(handle));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_EQ(&target.at(4), address);
+  EXPECT_EQ(target.at(4), "two!");
+  EXPECT_TRUE(source.extract(7).empty());
+}
+
+TEST(MapNodeHandle, RejectedNodeStaysInHandle) {
+  s21::map<int, int> first = {{1, 10}};
+  s21::map<int, int> second = {{1, 20}};
+  auto result = first.insert(second.extract(second.begin()));
+  EXPECT_FALSE(result.inserted);
+  ASSERT_FALSE(result.node.empty());
+  EXPECT_EQ(result.node.mapped(), 20);
+  EXPECT_EQ((*result.position).second, 10);
+  EXPECT_TRUE(second.empty());
+}
+
+TEST(MapNodeHandle, MergeWithMultimap) {
+  s21::map<int, int> map = {{1, 1}, {3, 3}};
+  s21::multimap<int, int> multimap = {{1, 10}, {2, 20}, {2, 21}, {3, 30}};
+  map.merge(multimap);
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(2), 20);
+  EXPECT_EQ(multimap.size(), 3U);  // 1, 2 and 3 were already in map
+  multimap.merge(map);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(multimap.size(), 6U);
+  EXPECT_EQ(multimap.count(2), 2U);
+}
+
+TEST(MapNodeHandle, UnequalAllocatorsMoveValues) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  using CountingMap = s21::map<int, int, std::less<int>, Alloc>;
+  Alloc first_alloc;
+  Alloc second_alloc;
+  {
+    CountingMap first({{1, 1}, {2, 2}}, first_alloc);
+    CountingMap second({{2, 20}, {3, 3}}, second_alloc);
+    first.merge(second);
+    EXPECT_EQ(first.size(), 3U);
+    EXPECT_EQ(second.size(), 1U);
+    EXPECT_EQ(first_alloc.stats()->live_objects, 3U);
+    EXPECT_EQ(second_alloc.stats()->live_objects, 1U);
+    auto rejected = first.insert(second.extract(second.begin()));
+    EXPECT_FALSE(rejected.inserted);
+    EXPECT_EQ(first_alloc.stats()->live_objects, 3U);
+    EXPECT_EQ(second_alloc.stats()->live_objects, 1U);  // held by the handle
+    rejected.node = decltype(rejected.node)();
+    EXPECT_EQ(second_alloc.stats()->live_objects, 0U);
+  }
+  EXPECT_EQ(first_alloc.stats()->live_objects, 0U);
+  EXPECT_EQ(second_alloc.stats()->live_objects, 0U);
+}
+
+TEST(MapNodeHandle, MergeBenchmark) {
+  const int kKeys = 200000;
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  using CountingMap = s21::map<int, int, std::less<int>, Alloc>;
+  Alloc alloc;
+  auto stats = alloc.stats();
+  CountingMap evens(alloc);
+  CountingMap odds(alloc);
+  for (int key = 0; key < kKeys; ++key) {
+    evens.insert(2 * key, key);
+    odds.insert(2 * key + 1, key);
+  }
+  const size_t allocations = stats->allocations;
+  auto start = std::chrono::steady_clock::now();
+  evens.merge(odds);
+  auto stop = std::chrono::steady_clock::now();
+  std::cout << "[ BENCH    ] merge of two " << kKeys << "-entry maps: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(stop -
+                                                                     start)
+                   .count()
+            << " ms, " << stats->allocations - allocations << " allocations"
+            << std::endl;
+  EXPECT_EQ(stats->allocations, allocations);
+  EXPECT_EQ(evens.size(), static_cast<size_t>(2 * kKeys));
+  EXPECT_TRUE(odds.empty());
+}
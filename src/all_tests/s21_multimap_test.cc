@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+#include "s21_tree_probe.h"
+
+TEST(S21multimapTest, DefaultConstructor) {
+  s21::multimap<int, int> multimap;
+  ASSERT_TRUE(multimap.empty());
+  EXPECT_EQ(multimap.size(), 0U);
+  EXPECT_TRUE(multimap.begin() == multimap.end());
+}
+
+TEST(S21multimapTest, InitializerListKeepsDuplicates) {
+  s21::multimap<int, std::string> multimap = {
+      {2, "b"}, {1, "a"}, {2, "c"}, {3, "d"}, {2, "e"}};
+  std::multimap<int, std::string> expected = {
+      {2, "b"}, {1, "a"}, {2, "c"}, {3, "d"}, {2, "e"}};
+  ASSERT_EQ(multimap.size(), expected.size());
+  auto it = multimap.begin();
+  for (const auto& item : expected) {
+    EXPECT_EQ((*it).first, item.first);
+    EXPECT_EQ((*it).second, item.second);
+    ++it;
+  }
+  EXPECT_TRUE(it == multimap.end());
+}
+
+TEST(S21multimapTest, InsertAndLookup) {
+  s21::multimap<int, int> multimap;
+  multimap.insert(5, 50);
+  multimap.insert(std::make_pair(5, 51));
+  auto last = multimap.emplace(5, 52);
+  multimap.insert(1, 10);
+  EXPECT_EQ(last->second, 52);
+  EXPECT_EQ(multimap.size(), 4U);
+  EXPECT_EQ(multimap.count(5), 3U);
+  EXPECT_EQ(multimap.count(7), 0U);
+  EXPECT_TRUE(multimap.contains(1));
+  EXPECT_FALSE(multimap.contains(2));
+  auto range = multimap.equal_range(5);
+  int value = 50;
+  for (auto it = range.first; it != range.second; ++it) {
+    EXPECT_EQ(it->second, value++);
+  }
+  EXPECT_EQ(value, 53);
+  EXPECT_EQ(multimap.find(5), range.first);
+  EXPECT_TRUE(multimap.find(4) == multimap.end());
+}
+
+TEST(S21multimapTest, EraseByKeyAndIterator) {
+  s21::multimap<int, int> multimap = {{1, 1}, {2, 2}, {2, 3}, {3, 4}};
+  auto next = multimap.erase(multimap.find(1));
+  EXPECT_EQ(next->first, 2);
+  EXPECT_EQ(multimap.erase(2), 2U);
+  EXPECT_EQ(multimap.erase(2), 0U);
+  EXPECT_EQ(multimap.size(), 1U);
+  EXPECT_EQ(multimap.begin()->second, 4);
+}
+
+TEST(S21multimapTest, CopyMoveAndMerge) {
+  s21::multimap<int, int> first = {{1, 1}, {2, 2}};
+  s21::multimap<int, int> second = {{2, 3}, {3, 4}};
+  s21::multimap<int, int> copy(first);
+  first.merge(second);
+  EXPECT_EQ(first.size(), 4U);
+  EXPECT_TRUE(second.empty());
+  EXPECT_EQ(first.count(2), 2U);
+  EXPECT_EQ(copy.size(), 2U);
+  s21::multimap<int, int> moved(std::move(first));
+  EXPECT_EQ(moved.size(), 4U);
+  moved.swap(copy);
+  EXPECT_EQ(moved.size(), 2U);
+  EXPECT_EQ(copy.size(), 4U);
+}
+
+TEST(S21multimapTest, AllocatorOwnsNodes) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  Alloc alloc;
+  auto stats = alloc.stats();
+  {
+    s21::multimap<int, int, std::less<int>, Alloc> multimap(
+        {{1, 1}, {1, 2}, {0, 3}}, alloc);
+    EXPECT_EQ(stats->live_objects, 3U);
+    multimap.erase(multimap.begin());
+    EXPECT_EQ(stats->live_objects, 2U);
+    EXPECT_EQ(multimap.get_allocator(), alloc);
+  }
+  EXPECT_EQ(stats->allocations, stats->deallocations);
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(S21multimapTest, BalancedWithManyDuplicates) {
+  s21_test::RedBlackProbe<s21::multimap<int, int>> multimap;
+  for (int step = 0; step < 3000; ++step) {
+    multimap.insert(step % 7, step);
+    if (step % 5 == 0) multimap.erase(multimap.begin());
+  }
+  EXPECT_GT(multimap.BlackHeight(), 0);
+  EXPECT_EQ(multimap.size(), 2400U);
+  int previous = -1;
+  for (auto it = multimap.begin(); it != multimap.end(); ++it) {
+    EXPECT_LE(previous, it->first);
+    previous = it->first;
+  }
+}
@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 #include "../s21_containers.h"
+#include "s21_counting_allocator.h"
+#include "s21_tree_probe.h"
 #include "../s21_containersplus.h"
 
 TEST(S21multisetTest, DefaultConstructor) {
@@ -191,3 +196,81 @@ TEST(S21multisetTest, LookupUpperBound) {
   auto it = multiset.upper_bound(3);
   ASSERT_EQ(*it, 7);
 }
+
+TEST(S21multisetTest, BoundsOfMissingKey) {
+  s21::multiset<int> multiset = {1, 3, 3, 7};
+  EXPECT_EQ(*multiset.lower_bound(2), 3);
+  EXPECT_EQ(*multiset.upper_bound(2), 3);
+  EXPECT_EQ(*multiset.lower_bound(0), 1);
+  EXPECT_TRUE(multiset.lower_bound(8) == multiset.end());
+  auto range = multiset.equal_range(5);
+  EXPECT_TRUE(range.first == range.second);
+  EXPECT_EQ(*range.first, 7);
+  EXPECT_EQ(multiset.count(5), 0U);
+}
+
+TEST(S21multisetTest, CountBenchmark) {
+  const int kElements = 200000;
+  const int kDistinct = 1000;
+  std::size_t calls = 0;
+  s21_test::RedBlackProbe<
+      s21::multiset<int, s21_test::CountingLess>::tree_type>
+      multiset(s21_test::CountingLess{&calls});
+  for (int i = 0; i < kElements; ++i) multiset.insert(i * 7919 % kDistinct);
+  const std::size_t height = multiset.Height();
+  calls = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::size_t total = 0;
+  for (int key = 0; key < kDistinct; ++key) {
+    total += multiset.count(key);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  std::cout << "[ BENCH    ] " << kDistinct << " count() on " << kElements
+            << " elements: "
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(stop -
+                                                                    start)
+                       .count() /
+                   kDistinct
+            << " ns/query, " << calls / kDistinct << " comparisons/query"
+            << std::endl;
+  EXPECT_EQ(total, static_cast<std::size_t>(kElements));
+  // two descents per query, independent of the number of elements
+  EXPECT_LE(calls, 2 * (height + 1) * kDistinct);
+}
+
+TEST(S21multisetTest, AllocatorOwnsNodes) {
+  s21_test::CountingAllocator<int> alloc;
+  auto stats = alloc.stats();
+  {
+    s21::multiset<int, std::less<int>, s21_test::CountingAllocator<int>>
+        values({5, 1, 3}, alloc);
+    EXPECT_EQ(stats->live_objects, 3U);
+    values.erase(values.begin());
+    EXPECT_EQ(stats->live_objects, 2U);
+    EXPECT_EQ(values.get_allocator(), alloc);
+  }
+  EXPECT_EQ(stats->allocations, stats->deallocations);
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(S21multisetTest, TransparentLookup) {
+  s21::multiset<std::string, std::less<>> multiset = {"b", "a", "b", "c", "b"};
+  std::string_view key = "b";
+  EXPECT_EQ(multiset.count(key), 3U);
+  auto range = multiset.equal_range(key);
+  EXPECT_EQ(*range.first, "b");
+  EXPECT_EQ(*range.second, "c");
+  EXPECT_EQ(*multiset.lower_bound(std::string_view("bb")), "c");
+  EXPECT_TRUE(multiset.upper_bound(std::string_view("c")) == multiset.end());
+}
+
+TEST(S21multisetTest, CustomCompare) {
+  s21::multiset<int, std::greater<int>> multiset = {1, 3, 2, 3};
+  auto it = multiset.begin();
+  for (int key : {3, 3, 2, 1}) {
+    EXPECT_EQ(*it, key);
+    ++it;
+  }
+  EXPECT_EQ(*multiset.lower_bound(2), 2);
+  EXPECT_EQ(*multiset.upper_bound(3), 2);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+
+TEST(PoolAllocator, RecyclesListNodes) {
+  s21::List<int, s21::PoolAllocator<int>> list;
+  for (int i = 0; i < 100; ++i) list.push_back(i);
+  const s21::NodePool::Stats &stats = list.get_allocator().stats();
+  EXPECT_EQ(stats.nodes_live, 100U);
+  EXPECT_EQ(stats.chunks_allocated, 1U);
+  size_t cached = stats.nodes_cached;
+
+  for (int i = 0; i < 50; ++i) list.pop_front();
+  EXPECT_EQ(stats.nodes_live, 50U);
+  EXPECT_EQ(stats.nodes_cached, cached + 50);
+
+  for (int i = 0; i < 50; ++i) list.push_back(i);
+  EXPECT_EQ(stats.nodes_live, 100U);
+  EXPECT_EQ(stats.nodes_cached, cached);
+  EXPECT_EQ(stats.chunks_allocated, 1U);
+
+  list.clear();
+  EXPECT_EQ(stats.nodes_live, 0U);
+  EXPECT_EQ(stats.nodes_cached, cached + 100);
+}
+
+TEST(PoolAllocator, GrowsByChunks) {
+  auto pool = std::make_shared<s21::NodePool>(1024);
+  s21::List<std::string, s21::PoolAllocator<std::string>> list(
+      s21::PoolAllocator<std::string>{pool});
+  for (int i = 0; i < 1000; ++i) list.push_back(std::to_string(i));
+  size_t per_chunk = (1024 - sizeof(void *) * 2) / pool->block_size();
+  EXPECT_GE(pool->block_size(), sizeof(std::string) + 2 * sizeof(void *));
+  EXPECT_GE(pool->stats().chunks_allocated, 1000 / (per_chunk + 1));
+  EXPECT_EQ(pool->stats().nodes_live, 1000U);
+  EXPECT_EQ(list.back(), "999");
+}
+
+TEST(PoolAllocator, SharedPoolBetweenLists) {
+  auto pool = std::make_shared<s21::NodePool>();
+  s21::PoolAllocator<int> alloc(pool);
+  {
+    s21::List<int, s21::PoolAllocator<int>> first({1, 2, 3}, alloc);
+    s21::List<int, s21::PoolAllocator<int>> second({4, 5}, alloc);
+    EXPECT_EQ(pool->stats().nodes_live, 5U);
+    first.swap(second);
+    EXPECT_EQ(first.size(), 2U);
+    second = std::move(first);
+    EXPECT_EQ(second.front(), 4);
+    EXPECT_EQ(pool->stats().nodes_live, 2U);
+  }
+  EXPECT_EQ(pool->stats().nodes_live, 0U);
+  EXPECT_EQ(pool->stats().chunks_allocated, 1U);
+}
+
+TEST(PoolAllocator, CopyGetsOwnPool) {
+  s21::List<int, s21::PoolAllocator<int>> list({1, 2, 3});
+  s21::List<int, s21::PoolAllocator<int>> copy(list);
+  EXPECT_NE(list.get_allocator(), copy.get_allocator());
+  EXPECT_EQ(copy.get_allocator().stats().nodes_live, 3U);
+  copy = list;
+  EXPECT_EQ(list.get_allocator().stats().nodes_live, 3U);
+  EXPECT_EQ(copy.get_allocator().stats().nodes_live, 3U);
+}
+
+TEST(PoolAllocator, OverAlignedNodesKeepAlignment) {
+  struct alignas(256) Big {
+    int value;
+  };
+  s21::List<Big, s21::PoolAllocator<Big>> list;
+  for (int i = 0; i < 64; ++i) {
+    list.push_back(Big{i});
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(&list.back()) % alignof(Big),
+              0U);
+  }
+  // over-aligned nodes bypass the pool
+  EXPECT_EQ(list.get_allocator().stats().nodes_live, 0U);
+  EXPECT_EQ(list.back().value, 63);
+}
+
+TEST(PoolAllocator, QueueChurn) {
+  s21::Queue<int, s21::List<int, s21::PoolAllocator<int>>> queue;
+  for (int round = 0; round < 1000; ++round) {
+    queue.push(round);
+    queue.push(round);
+    queue.pop();
+  }
+  EXPECT_EQ(queue.size(), 1000U);
+  EXPECT_EQ(queue.front(), 500);
+}
+
+template <typename ListType>
+long long ChurnWorkload(ListType &list, int depth, int rounds) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < depth; ++i) list.push_back(i);
+  for (int i = 0; i < rounds; ++i) {
+    list.push_back(i);
+    list.pop_front();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(stop - start)
+      .count();
+}
+
+TEST(PoolAllocator, ChurnBenchmark) {
+  const int kDepth = 1000;
+  const int kRounds = 200000;
+  s21_test::CountingAllocator<int> counting;
+  s21::List<int, s21_test::CountingAllocator<int>> plain(counting);
+  s21::List<int, s21::PoolAllocator<int>> pooled;
+  long long plain_us = ChurnWorkload(plain, kDepth, kRounds);
+  long long pooled_us = ChurnWorkload(pooled, kDepth, kRounds);
+  const s21::NodePool::Stats &stats = pooled.get_allocator().stats();
+  std::cout << "[ BENCH    ] push_back/pop_front churn, " << kRounds
+            << " rounds: heap nodes " << counting.stats()->allocations
+            << " allocations " << plain_us << " us, pooled nodes "
+            << stats.chunks_allocated << " chunks " << pooled_us << " us"
+            << std::endl;
+  EXPECT_EQ(counting.stats()->allocations,
+            static_cast<size_t>(kDepth + kRounds));
+  EXPECT_EQ(stats.nodes_live, static_cast<size_t>(kDepth));
+  EXPECT_LE(stats.chunks_allocated, 4U);
+  EXPECT_EQ(plain.front(), pooled.front());
+}
@@ -5,6 +5,7 @@
 #include "deque"
 #include "list"
 #include "queue"
+#include "s21_counting_allocator.h"
 
 using MyTypes = testing::Types<int, double, std::list<int>, std::string>;
 
@@ -437,3 +438,18 @@ TEST(QueueMethods, StringQueue) {
   EXPECT_EQ(que.front(), "2");
   EXPECT_EQ(que.size(), 5U);
 }
+
+TEST(QueueAllocatorTest, AllocatorReachesContainer) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  Alloc alloc;
+  auto stats = alloc.stats();
+  {
+    s21::Queue<int, s21::List<int, Alloc>> queue(alloc);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_EQ(stats->live_objects, 2U);
+    queue.pop();
+    EXPECT_EQ(stats->live_objects, 1U);
+  }
+  EXPECT_EQ(stats->live_objects, 0U);
+}
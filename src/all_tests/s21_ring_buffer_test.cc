@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+
+namespace {
+
+template <typename Buffer, typename Expected>
+void ExpectSameItems(const Buffer &buffer, const Expected &expected) {
+  ASSERT_EQ(buffer.size(), expected.size());
+  ASSERT_EQ(buffer.end() - buffer.begin(),
+            static_cast<std::ptrdiff_t>(expected.size()));
+  auto it = buffer.begin();
+  for (size_t i = 0; i < expected.size(); ++i, ++it) {
+    ASSERT_EQ(*it, expected[i]);
+    ASSERT_EQ(buffer[i], expected[i]);
+  }
+  ASSERT_TRUE(it == buffer.end());
+}
+
+/* Moves may throw, so growing falls back to copies, and the copy with
+ * value == fail_on throws */
+struct Fragile {
+  static int fail_on;
+  int value;
+  Fragile(int v) : value(v) {}
+  Fragile(const Fragile &other) : value(other.value) {
+    if (value == fail_on) throw std::runtime_error("copy failed");
+  }
+  Fragile(Fragile &&other) : Fragile(static_cast<const Fragile &>(other)) {}
+  Fragile &operator=(const Fragile &other) = default;
+  bool operator==(const Fragile &other) const { return value == other.value; }
+};
+int Fragile::fail_on = -1;
+
+template <typename QueueType>
+long long ChurnQueue(QueueType &queue, int depth, int rounds) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < depth; ++i) queue.push(i);
+  long long sum = 0;
+  for (int i = 0; i < rounds; ++i) {
+    queue.push(i);
+    sum += queue.front();
+    queue.pop();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  // pops return 0..depth-1, then the first rounds - depth pushes
+  long long tail = rounds - depth;
+  EXPECT_EQ(sum, 1LL * depth * (depth - 1) / 2 + tail * (tail - 1) / 2);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+      .count();
+}
+
+}  // namespace
+
+TEST(RingBuffer, DefaultConstructor) {
+  s21::ring_buffer<int> buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 0U);
+  EXPECT_TRUE(buffer.begin() == buffer.end());
+  EXPECT_THROW((void)buffer.at(0), std::out_of_range);
+}
+
+TEST(RingBuffer, RandomOperationsMatchStdDeque) {
+  s21::ring_buffer<std::string> buffer;
+  std::deque<std::string> expected;
+  unsigned seed = 17;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    std::string item = std::to_string(step);
+    switch ((seed >> 8) % 5) {
+      case 0:
+        buffer.push_front(item);
+        expected.push_front(item);
+        break;
+      case 1:
+      case 2:
+        buffer.push_back(item);
+        expected.push_back(item);
+        break;
+      case 3:
+        if (!expected.empty()) {
+          buffer.pop_front();
+          expected.pop_front();
+        }
+        break;
+      default:
+        if (!expected.empty()) {
+          buffer.pop_back();
+          expected.pop_back();
+        }
+    }
+    ASSERT_EQ(buffer.size(), expected.size());
+    if (!expected.empty()) {
+      ASSERT_EQ(buffer.front(), expected.front());
+      ASSERT_EQ(buffer.back(), expected.back());
+    }
+    // the capacity stays a power of two
+    ASSERT_EQ(buffer.capacity() & (buffer.capacity() - 1), 0U);
+  }
+  ExpectSameItems(buffer, expected);
+}
+
+TEST(RingBuffer, GrowsAcrossTheWrapPoint) {
+  s21::ring_buffer<int> buffer;
+  std::deque<int> expected;
+  for (int i = 0; i < 8; ++i) buffer.push_back(i);
+  ASSERT_EQ(buffer.capacity(), 8U);
+  for (int i = 0; i < 5; ++i) buffer.pop_front();
+  for (int i = 8; i < 13; ++i) buffer.push_back(i);  // wraps, still 8 slots
+  EXPECT_EQ(buffer.capacity(), 8U);
+  buffer.push_front(4);  // fills the last free slot
+  // the new element refers to an element of the full buffer
+  buffer.emplace_back(buffer.front());
+  EXPECT_EQ(buffer.capacity(), 16U);
+  for (int i = 4; i < 13; ++i) expected.push_back(i);
+  expected.push_back(4);
+  ExpectSameItems(buffer, expected);
+  buffer.emplace_front(buffer.back() - 1);
+  expected.push_front(3);
+  ExpectSameItems(buffer, expected);
+  buffer.reserve(100);
+  EXPECT_EQ(buffer.capacity(), 128U);
+  ExpectSameItems(buffer, expected);
+}
+
+TEST(RingBuffer, CopyMoveSwap) {
+  s21::ring_buffer<std::string> buffer = {"a", "b", "c"};
+  buffer.pop_front();
+  buffer.push_back("d");
+  s21::ring_buffer<std::string> copy(buffer);
+  ExpectSameItems(copy, std::deque<std::string>{"b", "c", "d"});
+  s21::ring_buffer<std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  ExpectSameItems(moved, std::deque<std::string>{"b", "c", "d"});
+  s21::ring_buffer<std::string> assigned = {"x"};
+  assigned = buffer;
+  ExpectSameItems(assigned, std::deque<std::string>{"b", "c", "d"});
+  s21::ring_buffer<std::string> other = {"y", "z"};
+  other.swap(assigned);
+  ExpectSameItems(assigned, std::deque<std::string>{"y", "z"});
+  assigned = std::move(other);
+  ExpectSameItems(assigned, std::deque<std::string>{"b", "c", "d"});
+  std::sort(assigned.begin(), assigned.end(), std::greater<std::string>());
+  ExpectSameItems(assigned, std::deque<std::string>{"d", "c", "b"});
+}
+
+TEST(RingBuffer, FailedGrowthKeepsContents) {
+  using Alloc = s21_test::CountingAllocator<Fragile>;
+  Alloc alloc;
+  {
+    s21::ring_buffer<Fragile, Alloc> buffer(alloc);
+    for (int i = 0; i < 8; ++i) buffer.push_back(i);
+    buffer.pop_front();
+    buffer.push_back(8);
+    Fragile::fail_on = 5;
+    EXPECT_THROW(buffer.push_back(9), std::runtime_error);
+    Fragile::fail_on = 9;
+    EXPECT_THROW(buffer.push_front(9), std::runtime_error);
+    Fragile::fail_on = -1;
+    EXPECT_EQ(buffer.capacity(), 8U);
+    ExpectSameItems(buffer, std::deque<Fragile>{1, 2, 3, 4, 5, 6, 7, 8});
+    EXPECT_EQ(alloc.stats()->allocations - alloc.stats()->deallocations, 1U);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+}
+
+TEST(RingBuffer, QueueSteadyStateDoesNotAllocate) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  Alloc alloc;
+  {
+    s21::Queue<int, s21::ring_buffer<int, Alloc>> queue(alloc);
+    for (int i = 0; i < 1000; ++i) queue.push(i);
+    for (int i = 0; i < 500; ++i) queue.pop();
+    size_t allocations = alloc.stats()->allocations;
+    for (int round = 0; round < 100000; ++round) {
+      queue.push(round);
+      queue.pop();
+    }
+    EXPECT_EQ(alloc.stats()->allocations, allocations);
+    EXPECT_EQ(queue.size(), 500U);
+    EXPECT_EQ(queue.front(), 99500);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+}
+
+TEST(RingBuffer, QueueBenchmark) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  const int depth = 1000, rounds = 200000;
+  Alloc list_alloc, ring_alloc;
+  s21::Queue<int, s21::List<int, Alloc>> list_queue(list_alloc);
+  s21::Queue<int, s21::ring_buffer<int, Alloc>> ring_queue(ring_alloc);
+  long long list_ns = ChurnQueue(list_queue, depth, rounds);
+  long long ring_ns = ChurnQueue(ring_queue, depth, rounds);
+  std::cout << "[ BENCH    ] queue push/pop x" << rounds << " at depth "
+            << depth << ", List: " << list_ns / rounds << " ns/op, "
+            << list_alloc.stats()->allocations
+            << " allocations, ring_buffer: " << ring_ns / rounds
+            << " ns/op, " << ring_alloc.stats()->allocations
+            << " allocations" << std::endl;
+  // one node per push for the list, log2(1024 / 8) + 1 arrays for the ring
+  EXPECT_EQ(list_alloc.stats()->allocations,
+            static_cast<size_t>(depth + rounds));
+  EXPECT_EQ(ring_alloc.stats()->allocations, 8U);
+}
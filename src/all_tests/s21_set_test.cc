@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+#include "s21_tree_probe.h"
 
 TEST(Group_exmple, example1) { ASSERT_TRUE(1 == 1); }
 
@@ -141,10 +151,327 @@ TEST(S21setTest, ModifierMerge) {
   s21::set<int> set2 = {3, 4, 5};
   set1.merge(set2);
   EXPECT_EQ(set1.size(), 5U);
-  EXPECT_EQ(set2.size(), 3U);
+  EXPECT_EQ(set2.size(), 1U);  // the duplicate stays behind
+  ASSERT_TRUE(set2.contains(3));
   ASSERT_TRUE(set1.contains(1));
   ASSERT_TRUE(set1.contains(2));
   ASSERT_TRUE(set1.contains(3));
   ASSERT_TRUE(set1.contains(4));
   ASSERT_TRUE(set1.contains(5));
 }
+
+TEST(S21setTest, LookupBounds) {
+  s21::set<int> set = {5, 1, 3};
+  EXPECT_EQ(set.count(3), 1U);
+  EXPECT_EQ(set.count(4), 0U);
+  EXPECT_EQ(*set.lower_bound(3), 3);
+  EXPECT_EQ(*set.lower_bound(4), 5);
+  EXPECT_EQ(*set.upper_bound(3), 5);
+  EXPECT_TRUE(set.upper_bound(5) == set.end());
+  auto range = set.equal_range(1);
+  EXPECT_EQ(*range.first, 1);
+  EXPECT_EQ(*range.second, 3);
+  range = set.equal_range(2);
+  EXPECT_TRUE(range.first == range.second);
+}
+
+TEST(S21setTest, AllocatorOwnsNodes) {
+  s21_test::CountingAllocator<int> alloc;
+  auto stats = alloc.stats();
+  {
+    s21::set<int, std::less<int>, s21_test::CountingAllocator<int>> values(
+        {5, 1, 3}, alloc);
+    EXPECT_EQ(stats->live_objects, 3U);
+    values.erase(values.begin());
+    EXPECT_EQ(stats->live_objects, 2U);
+    EXPECT_EQ(values.get_allocator(), alloc);
+  }
+  EXPECT_EQ(stats->allocations, stats->deallocations);
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(S21setTest, BalancedUnderRandomOperations) {
+  s21_test::RedBlackProbe<s21::multiset<int>::tree_type> tree;
+  std::multiset<int> expected;
+  unsigned seed = 77;
+  for (int step = 0; step < 4000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 300);
+    if ((seed >> 4) % 3 == 0) {
+      auto it = tree.find(key);
+      if (it != tree.end()) {
+        tree.erase(it);
+        expected.erase(expected.find(key));
+      }
+    } else {
+      tree.insert(key);
+      expected.insert(key);
+    }
+  }
+  ASSERT_GT(tree.BlackHeight(), 0);
+  ASSERT_EQ(tree.size(), expected.size());
+  auto it = tree.begin();
+  for (int key : expected) {
+    ASSERT_EQ(*it, key);
+    ++it;
+  }
+}
+
+TEST(S21setTest, SortedInsertBenchmark) {
+  const int kKeys = 1000000;
+  auto start = std::chrono::steady_clock::now();
+  size_t height = 0;
+  {
+    s21::set<int> set;
+    for (int key = 0; key < kKeys; ++key) set.insert(key);
+    EXPECT_EQ(set.size(), static_cast<size_t>(kKeys));
+    EXPECT_TRUE(set.contains(kKeys - 1));
+    s21_test::RedBlackProbe<s21::set<int>::tree_type> tree;
+    for (int key = kKeys; key > 0; key -= 100) tree.insert(key);
+    height = tree.Height();
+  }  // destroying a deep tree must not recurse
+  auto stop = std::chrono::steady_clock::now();
+  std::cout << "[ BENCH    ] " << kKeys
+            << " increasing keys into s21::set and teardown: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(stop -
+                                                                     start)
+                   .count()
+            << " ms" << std::endl;
+  EXPECT_LE(height, 28U);
+}
+
+TEST(S21setTest, CustomCompare) {
+  s21::set<int, std::greater<int>> set = {1, 5, 3, 5};
+  std::set<int, std::greater<int>> expected = {1, 5, 3, 5};
+  ASSERT_EQ(set.size(), expected.size());
+  auto it = set.begin();
+  for (int key : expected) {
+    EXPECT_EQ(*it, key);
+    ++it;
+  }
+  EXPECT_TRUE(set.contains(3));
+  EXPECT_FALSE(set.contains(4));
+}
+
+TEST(S21setTest, TransparentLookup) {
+  s21::set<std::string, std::less<>> set = {"red", "green", "blue"};
+  std::string_view key = "green";
+  auto it = set.find(key);
+  ASSERT_TRUE(it != set.end());
+  EXPECT_EQ(*it, "green");
+  EXPECT_TRUE(set.contains(std::string_view("blue")));
+  EXPECT_FALSE(set.contains(std::string_view("black")));
+}
+
+TEST(S21setRanked, UnrankedNodesCarryNoSize) {
+  EXPECT_EQ(sizeof(s21::TreeNode<long>),
+            sizeof(s21::TreeNodeBase) + sizeof(long));
+  EXPECT_EQ(sizeof(s21::TreeNode<long, true>),
+            sizeof(s21::TreeNode<long>) + sizeof(std::size_t));
+}
+
+TEST(S21setRanked, NthAndRankUnderRandomOperations) {
+  using RankedSet = s21::set<int, std::less<int>, std::allocator<int>, true>;
+  s21_test::RedBlackProbe<RankedSet::tree_type> set;
+  std::set<int> expected;
+  unsigned seed = 4242;
+  for (int step = 0; step < 3000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 500);
+    if ((seed >> 4) % 3 == 0) {
+      auto it = set.find(key);
+      if (it != set.end()) set.erase(it);
+      expected.erase(key);
+    } else {
+      set.insert(key);
+      expected.insert(key);
+    }
+  }
+  ASSERT_GT(set.BlackHeight(), 0);  // also checks every subtree size
+  size_t k = 0;
+  for (int key : expected) {
+    ASSERT_EQ(*set.nth(k), key);
+    ASSERT_EQ(set.index(set.find(key)), k);
+    ++k;
+  }
+  EXPECT_TRUE(set.nth(k) == set.end());
+  for (int key = -1; key <= 500; ++key) {
+    auto bound = expected.lower_bound(key);
+    ASSERT_EQ(set.rank(key),
+              static_cast<size_t>(std::distance(expected.begin(), bound)));
+  }
+}
+
+TEST(S21setRanked, WrapperAndDistance) {
+  s21::set<int, std::greater<int>, std::allocator<int>, true> set = {
+      10, 40, 20, 30};
+  EXPECT_EQ(*set.nth(0), 40);
+  EXPECT_EQ(*set.nth(3), 10);
+  EXPECT_EQ(set.rank(25), 2U);
+  EXPECT_EQ(set.distance(set.find(30), set.end()), 3U);
+  EXPECT_EQ(set.index(set.end()), set.size());
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> multiset = {
+      1, 2, 2, 2, 3};
+  EXPECT_EQ(multiset.count(2), 3U);
+  EXPECT_EQ(multiset.rank(3), 4U);
+  EXPECT_EQ(*multiset.nth(2), 2);
+}
+
+TEST(S21setRanked, SelectBenchmark) {
+  const int kKeys = 100000;
+  const int kQueries = 200;
+  s21::set<int, std::less<int>, std::allocator<int>, true> ranked;
+  std::set<int> plain;
+  for (int key = 0; key < kKeys; ++key) {
+    ranked.insert(key * 3);
+    plain.insert(key * 3);
+  }
+  long long checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int q = 0; q < kQueries; ++q) {
+    checksum += *ranked.nth(static_cast<size_t>(q) * kKeys / kQueries);
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (int q = 0; q < kQueries; ++q) {
+    checksum -= *std::next(plain.begin(), q * (kKeys / kQueries));
+  }
+  auto stop = std::chrono::steady_clock::now();
+  std::cout << "[ BENCH    ] " << kQueries << " k-th element queries on "
+            << kKeys << " keys: nth() "
+            << std::chrono::duration_cast<std::chrono::microseconds>(middle -
+                                                                     start)
+                   .count()
+            << " us, std::next from begin() "
+            << std::chrono::duration_cast<std::chrono::microseconds>(stop -
+                                                                     middle)
+                   .count()
+            << " us" << std::endl;
+  EXPECT_EQ(checksum, 0);
+}
+
+TEST(S21setBulk, FromSortedIsBalancedForEverySize) {
+  using Tree = s21::multiset<int, std::less<int>, std::allocator<int>,
+                             true>::tree_type;
+  std::vector<int> keys;
+  for (int n = 0; n <= 300; ++n) {
+    s21_test::RedBlackProbe<Tree> tree;
+    tree.assign_sorted(keys.begin(), keys.end());
+    ASSERT_EQ(tree.size(), keys.size());
+    ASSERT_GE(tree.BlackHeight(), 0) << n;  // also checks subtree sizes
+    size_t levels = 0;
+    while ((size_t{1} << levels) <= keys.size()) ++levels;
+    ASSERT_EQ(tree.Height(), levels) << n;
+    ASSERT_TRUE(std::equal(keys.begin(), keys.end(), tree.begin()));
+    keys.push_back(n / 2);
+  }
+}
+
+TEST(S21setBulk, FromSortedSkipsDuplicatesInSet) {
+  std::vector<int> keys = {1, 1, 2, 3, 3, 3, 8};
+  auto set = s21::set<int>::from_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 4U);
+  auto multiset = s21::multiset<int>::from_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(multiset.size(), keys.size());
+  EXPECT_EQ(multiset.count(3), 3U);
+  auto reversed = s21::set<int, std::greater<int>>::from_sorted(
+      keys.rbegin(), keys.rend());
+  EXPECT_EQ(*reversed.begin(), 8);
+  EXPECT_EQ(reversed.size(), 4U);
+}
+
+TEST(S21setBulk, CopyClonesStructureWithoutComparing) {
+  size_t calls = 0;
+  using Probe = s21_test::RedBlackProbe<
+      s21::set<int, s21_test::CountingLess>::tree_type>;
+  Probe original(s21_test::CountingLess{&calls});
+  unsigned seed = 99;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    original.insert(static_cast<int>(seed >> 12));
+  }
+  calls = 0;
+  Probe copy(original);
+  EXPECT_EQ(calls, 0U);
+  EXPECT_EQ(copy.size(), original.size());
+  EXPECT_EQ(copy.Height(), original.Height());
+  EXPECT_EQ(copy.BlackHeight(), original.BlackHeight());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), original.begin()));
+  copy.insert(-1);
+  EXPECT_EQ(*copy.begin(), -1);
+  EXPECT_NE(*original.begin(), -1);
+}
+
+TEST(S21setBulk, FailedCopyReleasesNodes) {
+  struct Fragile {
+    int key;
+    std::shared_ptr<int> copies_left;
+    Fragile(int k, std::shared_ptr<int> left) : key(k), copies_left(left) {}
+    Fragile(const Fragile& other)
+        : key(other.key), copies_left(other.copies_left) {
+      if ((*copies_left)-- == 0) throw std::runtime_error("copy");
+    }
+    bool operator<(const Fragile& other) const { return key < other.key; }
+  };
+  using Alloc = s21_test::CountingAllocator<Fragile>;
+  Alloc alloc;
+  auto stats = alloc.stats();
+  auto budget = std::make_shared<int>(1000);
+  {
+    using FragileSet = s21::set<Fragile, std::less<Fragile>, Alloc>;
+    FragileSet set(alloc);
+    for (int key = 0; key < 100; ++key) set.insert(Fragile(key, budget));
+    *budget = 40;
+    EXPECT_THROW(FragileSet copy(set), std::runtime_error);
+    EXPECT_EQ(stats->live_objects, 100U);
+  }
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(S21setDeep, DegenerateTreeTeardownAndCopy) {
+  // a million levels: recursion on the height would need far more than
+  // the default 8 MB stack
+  const size_t kDepth = 1000000;
+  using Probe = s21_test::RedBlackProbe<s21::set<int>::tree_type>;
+  Probe deep;
+  deep.insert(-1);
+  deep.GrowChain(kDepth, [](size_t i) { return static_cast<int>(i); });
+  ASSERT_EQ(deep.Height(), kDepth + 1);
+  {
+    Probe copy(deep);
+    EXPECT_EQ(copy.Height(), kDepth + 1);
+    size_t visited = 0;
+    int previous = -2;
+    for (int key : copy) {
+      ASSERT_LT(previous, key);
+      previous = key;
+      ++visited;
+    }
+    EXPECT_EQ(visited, kDepth + 1);
+  }  // teardown of the copy
+  deep.clear();
+  EXPECT_TRUE(deep.empty());
+  EXPECT_EQ(deep.Height(), 0U);
+}
+
+TEST(S21setNodeHandle, ExtractInsertAndMerge) {
+  s21::set<std::string> names = {"ann", "bob"};
+  s21::set<std::string> others = {"bob", "cid"};
+  auto handle = names.extract("ann");
+  ASSERT_FALSE(handle.empty());
+  const std::string* address = &handle.value();
+  handle.value() = "amy";
+  auto result = others.insert(std::move(handle));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(&*result.position, address);
+  names.merge(others);
+  EXPECT_EQ(names.size(), 3U);
+  EXPECT_EQ(others.size(), 1U);
+  EXPECT_TRUE(others.contains("bob"));
+  s21::multiset<int> bag = {1, 1, 2};
+  s21::multiset<int> more = {1, 3};
+  bag.insert(more.extract(more.begin()));
+  EXPECT_EQ(bag.count(1), 3U);
+  bag.merge(more);
+  EXPECT_EQ(bag.size(), 5U);
+  EXPECT_TRUE(more.empty());
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(SmallVector, StartsInline) {
+  s21::SmallVector<int, 8> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_EQ(vec.capacity(), 8U);
+  EXPECT_TRUE(vec.is_inline());
+  for (int i = 0; i < 8; ++i) vec.push_back(i);
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 8U);
+  vec.push_back(8);
+  EXPECT_FALSE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 16U);
+  for (int i = 0; i < 9; ++i) EXPECT_EQ(vec[i], i);
+}
+
+TEST(SmallVector, Constructors) {
+  s21::SmallVector<std::string, 4> list{"a", "b", "c"};
+  EXPECT_TRUE(list.is_inline());
+  EXPECT_EQ(list.size(), 3U);
+  EXPECT_EQ(list[2], "c");
+
+  s21::SmallVector<std::string, 2> big{"a", "b", "c"};
+  EXPECT_FALSE(big.is_inline());
+  EXPECT_EQ(big.capacity(), 3U);
+
+  s21::SmallVector<int, 4> sized(3);
+  EXPECT_TRUE(sized.is_inline());
+  EXPECT_EQ(sized.size(), 3U);
+  EXPECT_EQ(sized[2], 0);
+
+  s21::SmallVector<int, 4> filled(6, 7);
+  EXPECT_EQ(filled.size(), 6U);
+  EXPECT_EQ(filled[5], 7);
+
+  s21::SmallVector<std::string, 4> copy(list);
+  EXPECT_TRUE(copy.is_inline());
+  EXPECT_NE(copy.data(), list.data());
+  EXPECT_EQ(copy[1], "b");
+}
+
+TEST(SmallVector, MoveInline) {
+  s21::SmallVector<std::string, 4> vec{"a", "b"};
+  s21::SmallVector<std::string, 4> moved(std::move(vec));
+  EXPECT_TRUE(moved.is_inline());
+  EXPECT_EQ(moved.size(), 2U);
+  EXPECT_EQ(moved[1], "b");
+  EXPECT_TRUE(vec.empty());
+  EXPECT_TRUE(vec.is_inline());
+
+  vec = std::move(moved);
+  EXPECT_EQ(vec.size(), 2U);
+  EXPECT_EQ(vec[0], "a");
+}
+
+TEST(SmallVector, MoveHeap) {
+  s21::SmallVector<std::string, 2> vec{"a", "b", "c"};
+  auto data = vec.data();
+  s21::SmallVector<std::string, 2> moved(std::move(vec));
+  EXPECT_EQ(moved.data(), data);
+  EXPECT_TRUE(vec.empty());
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 2U);
+  vec.push_back("d");
+  EXPECT_EQ(vec[0], "d");
+}
+
+TEST(SmallVector, Swap) {
+  s21::SmallVector<std::string, 2> small{"x"};
+  s21::SmallVector<std::string, 2> big{"a", "b", "c"};
+  small.swap(big);
+  EXPECT_EQ(small.size(), 3U);
+  EXPECT_FALSE(small.is_inline());
+  EXPECT_EQ(big.size(), 1U);
+  EXPECT_TRUE(big.is_inline());
+  EXPECT_EQ(big[0], "x");
+
+  s21::SmallVector<std::string, 2> other{"y", "z"};
+  big.swap(other);
+  EXPECT_EQ(big[1], "z");
+  EXPECT_EQ(other[0], "x");
+}
+
+TEST(SmallVector, ShrinkBackInline) {
+  s21::SmallVector<int, 4> vec{1, 2, 3, 4, 5, 6};
+  EXPECT_FALSE(vec.is_inline());
+  vec.erase(vec.begin() + 2, vec.end());
+  vec.shrink_to_fit();
+  EXPECT_TRUE(vec.is_inline());
+  EXPECT_EQ(vec.capacity(), 4U);
+  EXPECT_EQ(vec[1], 2);
+  vec.shrink_to_fit();
+  EXPECT_EQ(vec.capacity(), 4U);
+}
+
+TEST(SmallVector, VectorInterface) {
+  s21::SmallVector<std::string, 4> vec;
+  vec.emplace_back("b");
+  vec.insert(vec.begin(), "a");
+  vec.insert_many_back("c", "d", "e");
+  vec.erase(vec.begin() + 1);
+  vec.resize(6, "z");
+  std::vector<std::string> expected{"a", "c", "d", "e", "z", "z"};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (size_t i = 0; i < vec.size(); ++i) EXPECT_EQ(vec.at(i), expected[i]);
+  vec.clear();
+  EXPECT_TRUE(vec.empty());
+}
+
+template <typename V>
+std::pair<size_t, long long> SmallWorkload(size_t elements, int rounds) {
+  size_t allocations = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    V vec;
+    for (size_t i = 0; i < elements; ++i) vec.push_back(static_cast<int>(i));
+    allocations += vec.growth_policy().reallocations();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  return {allocations / rounds, elapsed.count() / rounds};
+}
+
+TEST(SmallVector, AllocationBenchmark) {
+  using Counted = s21::growth::Counted<>;
+  const int kRounds = 2000;
+  for (size_t elements : {1U, 4U, 8U, 16U, 64U}) {
+    auto plain = SmallWorkload<s21::Vector<int, Counted>>(elements, kRounds);
+    auto small =
+        SmallWorkload<s21::SmallVector<int, 8, Counted>>(elements, kRounds);
+    std::cout << "[ BENCH    ] " << elements << " elements: Vector "
+              << plain.first << " allocations " << plain.second
+              << " ns, SmallVector<8> " << small.first << " allocations "
+              << small.second << " ns" << std::endl;
+    if (elements <= 8) {
+      EXPECT_EQ(small.first, 0U);
+    }
+    EXPECT_LT(small.first, plain.first);
+  }
+}
@@ -3,6 +3,7 @@
 #include <stack>
 
 #include "gtest/gtest.h"
+#include "s21_counting_allocator.h"
 
 TEST(StackTest, DefaultConstructor) {
   s21::stack<int> my_stack;
@@ -219,3 +220,15 @@ TEST(StackTest, InitializerListConstructor2) {
   stack.pop();
   EXPECT_EQ(stack.empty(), true);
 }
+
+TEST(StackTest, AllocatorOwnsNodes) {
+  s21_test::CountingAllocator<int> alloc;
+  auto stats = alloc.stats();
+  {
+    s21::stack<int, s21_test::CountingAllocator<int>> my_stack({1, 2}, alloc);
+    my_stack.push(3);
+    EXPECT_EQ(stats->live_objects, 3U);
+    EXPECT_EQ(my_stack.get_allocator(), alloc);
+  }
+  EXPECT_EQ(stats->live_objects, 0U);
+}
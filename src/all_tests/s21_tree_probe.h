@@ -0,0 +1,114 @@
+#ifndef CPP2_S21_CONTAINERS_1_ALL_TESTS_TREE_PROBE_H
+#define CPP2_S21_CONTAINERS_1_ALL_TESTS_TREE_PROBE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace s21_test {
+
+/* Gives tests access to the nodes of an s21::tree based container to check
+ * the red-black properties and the height of the tree */
+template <typename TreeType>
+class RedBlackProbe : public TreeType {
+ public:
+  using TreeType::TreeType;
+  using NodeBase = typename TreeType::NodeBase;
+
+  /* Black height of the tree or -1 if a red-black property is broken */
+  int BlackHeight() const {
+    if (this->empty()) return 0;
+    const NodeBase* root = this->return_root();
+    if (root->is_red || root->parent_ != this->end().curr_node) return -1;
+    if constexpr (TreeType::is_ranked) {
+      if (CountNodes(root) != this->size()) return -1;
+    }
+    return CheckSubtree(root);
+  }
+
+  std::size_t Height() const { return Depth(this->return_root()); }
+
+  /* Hangs count nodes made by make_value(i) below the root as a right
+   * leaning chain, bypassing balancing and the size counter, to get a tree
+   * as deep as possible. The tree must hold exactly one element and the
+   * values must be increasing */
+  template <typename MakeValue>
+  void GrowChain(std::size_t count, MakeValue make_value) {
+    NodeBase* tail = this->return_root();
+    for (std::size_t i = 0; i < count; ++i) {
+      NodeBase* item = this->create_node(make_value(i));
+      item->is_red = false;
+      item->parent_ = tail;
+      tail->right_node_ = item;
+      tail = item;
+    }
+  }
+
+ private:
+  int CheckSubtree(const NodeBase* item) const {
+    if (!item) return 1;
+    for (const NodeBase* child : {item->left_node_, item->right_node_}) {
+      if (!child) continue;
+      if (child->parent_ != item) return -1;
+      if (item->is_red && child->is_red) return -1;
+    }
+    auto comp = this->key_comp();
+    if (item->left_node_ &&
+        comp(this->key_of(item), this->key_of(item->left_node_))) {
+      return -1;
+    }
+    if (item->right_node_ &&
+        comp(this->key_of(item->right_node_), this->key_of(item))) {
+      return -1;
+    }
+    int left = CheckSubtree(item->left_node_);
+    int right = CheckSubtree(item->right_node_);
+    if (left < 0 || left != right) return -1;
+    return left + (item->is_red ? 0 : 1);
+  }
+
+  /* Number of nodes below item or -1 if a stored subtree size is wrong */
+  static std::size_t CountNodes(const NodeBase* item) {
+    if (!item) return 0;
+    std::size_t left = CountNodes(item->left_node_);
+    std::size_t right = CountNodes(item->right_node_);
+    const std::size_t broken = static_cast<std::size_t>(-1);
+    if (left == broken || right == broken) return broken;
+    using Node = typename TreeType::Node;
+    if (static_cast<const Node*>(item)->subtree_size != left + right + 1) {
+      return broken;
+    }
+    return left + right + 1;
+  }
+
+  /* Height by a level-order walk, so degenerate trees are fine too */
+  static std::size_t Depth(const NodeBase* item) {
+    std::vector<const NodeBase*> level;
+    if (item) level.push_back(item);
+    std::size_t depth = 0;
+    while (!level.empty()) {
+      std::vector<const NodeBase*> next;
+      for (const NodeBase* node : level) {
+        if (node->left_node_) next.push_back(node->left_node_);
+        if (node->right_node_) next.push_back(node->right_node_);
+      }
+      level.swap(next);
+      ++depth;
+    }
+    return depth;
+  }
+};
+
+/* Strict weak ordering on int that counts how often it is called */
+struct CountingLess {
+  std::size_t* calls;
+  bool operator()(int a, int b) const {
+    ++*calls;
+    return a < b;
+  }
+};
+
+}  // namespace s21_test
+
+#endif  // CPP2_S21_CONTAINERS_1_ALL_TESTS_TREE_PROBE_H
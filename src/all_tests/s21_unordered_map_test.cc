@@ -0,0 +1,302 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#include "s21_counting_allocator.h"
+
+namespace {
+
+template <typename Map, typename Expected>
+void ExpectSameItems(const Map &my_map, const Expected &expected) {
+  ASSERT_EQ(my_map.size(), expected.size());
+  size_t visited = 0;
+  for (const auto &item : my_map) {
+    auto found = expected.find(item.first);
+    ASSERT_TRUE(found != expected.end());
+    ASSERT_EQ(item.second, found->second);
+    ++visited;
+  }
+  ASSERT_EQ(visited, expected.size());
+}
+
+/* Sends every key to one of a few values, so probes run long and control
+ * bytes collide */
+struct PoorHash {
+  size_t operator()(int key) const noexcept { return key % 3; }
+};
+
+struct CountingEqual {
+  size_t *calls;
+  bool operator()(int a, int b) const {
+    ++*calls;
+    return a == b;
+  }
+};
+
+}  // namespace
+
+TEST(UnorderedMap, DefaultConstructor) {
+  s21::unordered_map<int, int> my_map;
+  EXPECT_TRUE(my_map.empty());
+  EXPECT_EQ(my_map.bucket_count(), 0U);
+  EXPECT_TRUE(my_map.begin() == my_map.end());
+  EXPECT_FALSE(my_map.contains(1));
+  EXPECT_EQ(my_map.erase(1), 0U);
+  EXPECT_TRUE(my_map.find(1) == my_map.end());
+}
+
+TEST(UnorderedMap, ElementAccess) {
+  s21::unordered_map<std::string, int> my_map = {{"one", 1}, {"two", 2}};
+  EXPECT_EQ(my_map.at("one"), 1);
+  EXPECT_THROW((void)my_map.at("three"), std::out_of_range);
+  const auto &const_map = my_map;
+  EXPECT_EQ(const_map.at("two"), 2);
+  EXPECT_THROW((void)const_map.at("zero"), std::out_of_range);
+  my_map["three"] = 3;
+  ++my_map["one"];
+  ExpectSameItems(my_map, std::map<std::string, int>{
+                              {"one", 2}, {"two", 2}, {"three", 3}});
+}
+
+TEST(UnorderedMap, InsertVariants) {
+  s21::unordered_map<int, std::string> my_map;
+  EXPECT_TRUE(my_map.insert({1, "a"}).second);
+  EXPECT_FALSE(my_map.insert(1, "b").second);
+  auto assigned = my_map.insert_or_assign(1, "c");
+  EXPECT_FALSE(assigned.second);
+  EXPECT_EQ(assigned.first->second, "c");
+  auto placed = my_map.try_emplace(2, 3, 'x');
+  EXPECT_TRUE(placed.second);
+  EXPECT_EQ(placed.first->second, "xxx");
+  EXPECT_FALSE(my_map.emplace(2, "y").second);
+  EXPECT_TRUE(my_map.emplace(3, "z").second);
+  ExpectSameItems(my_map, std::map<int, std::string>{
+                              {1, "c"}, {2, "xxx"}, {3, "z"}});
+}
+
+TEST(UnorderedMap, RandomOperationsMatchStdMap) {
+  s21::unordered_map<int, int> my_map;
+  s21::unordered_map<int, int, PoorHash> colliding;
+  std::unordered_map<int, int> expected;
+  unsigned seed = 11;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 2000);
+    if ((seed >> 4) % 3 == 0) {
+      size_t erased = expected.erase(key);
+      ASSERT_EQ(my_map.erase(key), erased);
+      if (key < 300) {
+        ASSERT_EQ(colliding.erase(key), erased);
+      }
+    } else {
+      bool inserted = expected.insert({key, step}).second;
+      ASSERT_EQ(my_map.insert(key, step).second, inserted);
+      if (key < 300) {
+        ASSERT_EQ(colliding.insert(key, step).second, inserted);
+      }
+    }
+    ASSERT_LE(my_map.load_factor(), my_map.max_load_factor());
+  }
+  ExpectSameItems(my_map, expected);
+  for (auto it = expected.begin(); it != expected.end();) {
+    it = it->first < 300 ? std::next(it) : expected.erase(it);
+  }
+  ExpectSameItems(colliding, expected);
+}
+
+TEST(UnorderedMap, EraseDuringIteration) {
+  s21::unordered_map<int, int> my_map;
+  for (int key = 0; key < 1000; ++key) my_map[key] = key;
+  for (auto it = my_map.begin(); it != my_map.end();) {
+    it = it->first % 2 ? my_map.erase(it) : std::next(it);
+  }
+  EXPECT_EQ(my_map.size(), 500U);
+  for (int key = 0; key < 1000; ++key) {
+    ASSERT_EQ(my_map.contains(key), key % 2 == 0);
+  }
+}
+
+TEST(UnorderedMap, TombstonesAreReused) {
+  s21::unordered_map<int, int> my_map;
+  my_map.reserve(100);
+  size_t buckets = my_map.bucket_count();
+  // churn through far more keys than fit, the table must not grow
+  for (int key = 0; key < 100000; ++key) {
+    my_map[key] = key;
+    if (key >= 50) my_map.erase(key - 50);
+  }
+  EXPECT_EQ(my_map.size(), 50U);
+  EXPECT_EQ(my_map.bucket_count(), buckets);
+  for (int key = 99950; key < 100000; ++key) ASSERT_EQ(my_map.at(key), key);
+}
+
+TEST(UnorderedMap, LoadFactorIsConfigurable) {
+  s21::unordered_map<int, int> my_map;
+  EXPECT_FLOAT_EQ(my_map.max_load_factor(), 0.875f);
+  my_map.max_load_factor(0.5f);
+  for (int key = 0; key < 1000; ++key) {
+    my_map[key] = key;
+    ASSERT_LE(my_map.load_factor(), 0.5f);
+  }
+  EXPECT_GE(my_map.bucket_count(), 2000U);
+  my_map.max_load_factor(1.0f);
+  EXPECT_LT(my_map.bucket_count(), 2000U);
+  EXPECT_THROW(my_map.max_load_factor(0.0f), std::invalid_argument);
+  EXPECT_THROW(my_map.max_load_factor(1.5f), std::invalid_argument);
+  for (int key = 0; key < 1000; ++key) ASSERT_EQ(my_map.at(key), key);
+  for (int key = 0; key < 1000; ++key) my_map.erase(key);
+  my_map.rehash(0);
+  EXPECT_EQ(my_map.bucket_count(), 0U);
+}
+
+TEST(UnorderedMap, CopyMoveSwapMerge) {
+  s21::unordered_map<int, std::string> my_map;
+  std::map<int, std::string> expected;
+  for (int key = 0; key < 300; ++key) {
+    my_map[key] = std::to_string(key);
+    expected[key] = std::to_string(key);
+  }
+  s21::unordered_map<int, std::string> copy(my_map);
+  ExpectSameItems(copy, expected);
+  s21::unordered_map<int, std::string> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  ExpectSameItems(moved, expected);
+  s21::unordered_map<int, std::string> assigned = {{-1, "x"}};
+  assigned = moved;
+  ExpectSameItems(assigned, expected);
+  s21::unordered_map<int, std::string> other = {{-2, "y"}, {0, "z"}};
+  other.swap(assigned);
+  ExpectSameItems(assigned, std::map<int, std::string>{{-2, "y"}, {0, "z"}});
+  other.merge(assigned);
+  expected[-2] = "y";
+  ExpectSameItems(other, expected);
+  ExpectSameItems(assigned, std::map<int, std::string>{{0, "z"}});
+}
+
+TEST(UnorderedMap, AllocatorOwnsArrays) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  Alloc alloc;
+  {
+    s21::unordered_map<int, int, std::hash<int>, std::equal_to<int>, Alloc>
+        my_map(alloc);
+    for (int key = 0; key < 1000; ++key) my_map[key] = key;
+    auto copy = my_map;
+    copy.clear();
+    for (int key = 0; key < 1000; key += 2) my_map.erase(key);
+    // one array of slots and one of control bytes
+    EXPECT_EQ(alloc.stats()->allocations - alloc.stats()->deallocations, 4U);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+}
+
+TEST(UnorderedMap, FailedCopyReleasesSlots) {
+  struct Fragile {
+    int value = 0;
+    Fragile(int v) : value(v) {}
+    Fragile(const Fragile &other) : value(other.value) {
+      if (value == 150) throw std::runtime_error("copy failed");
+    }
+    Fragile(Fragile &&other) noexcept = default;
+  };
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, Fragile>>;
+  using FragileMap =
+      s21::unordered_map<int, Fragile, std::hash<int>, std::equal_to<int>,
+                         Alloc>;
+  Alloc alloc;
+  {
+    FragileMap my_map(alloc);
+    for (int key = 0; key < 200; ++key) my_map.try_emplace(key, key);
+    size_t live = alloc.stats()->live_objects;
+    EXPECT_THROW(FragileMap copy(my_map), std::runtime_error);
+    EXPECT_EQ(alloc.stats()->live_objects, live);
+  }
+  EXPECT_EQ(alloc.stats()->live_objects, 0U);
+}
+
+TEST(UnorderedMap, GroupMatchesEveryControlByte) {
+  using s21::hash::ctrl_t;
+  using s21::hash::Group;
+  using s21::hash::GroupPortable;
+  ctrl_t ctrl[Group::kWidth];
+  unsigned seed = 3;
+  for (int round = 0; round < 2000; ++round) {
+    for (ctrl_t &byte : ctrl) {
+      seed = seed * 1103515245U + 12345U;
+      unsigned pick = seed >> 16;
+      // mostly full slots, the rest spread over the three markers
+      byte = pick % 4 ? static_cast<ctrl_t>(pick % 128)
+             : pick % 3 == 0 ? s21::hash::kEmpty
+             : pick % 3 == 1 ? s21::hash::kDeleted
+                             : s21::hash::kSentinel;
+    }
+    Group group(ctrl);
+    GroupPortable portable(ctrl);
+    auto same = [](s21::hash::BitMask a, s21::hash::BitMask b) {
+      for (; a && b; ++a, ++b) {
+        if (a.lowest() != b.lowest()) return false;
+      }
+      return !a && !b;
+    };
+    ctrl_t h2 = static_cast<ctrl_t>(seed % 128);
+    ASSERT_TRUE(same(group.match(h2), portable.match(h2)));
+    ASSERT_TRUE(same(group.match(ctrl[round % Group::kWidth]),
+                     portable.match(ctrl[round % Group::kWidth])));
+    ASSERT_TRUE(same(group.match_empty(), portable.match_empty()));
+    ASSERT_TRUE(same(group.match_empty_or_deleted(),
+                     portable.match_empty_or_deleted()));
+  }
+}
+
+TEST(UnorderedMap, LookupBenchmark) {
+  // 10^3..10^5 keys; larger tables make the repeated test run too long
+  for (int keys : {1000, 10000, 100000}) {
+    std::vector<int> present(keys), absent(keys);
+    unsigned seed = 777;
+    for (int i = 0; i < keys; ++i) {
+      seed = seed * 1103515245U + 12345U;
+      present[i] = static_cast<int>(seed >> 1) | 1;
+      absent[i] = present[i] - 1;  // even keys are never inserted
+    }
+    auto start = std::chrono::steady_clock::now();
+    s21::map<int, int> tree_map;
+    for (int key : present) tree_map[key] = key;
+    long tree_sum = 0;
+    for (int key : present) tree_sum += tree_map.find(key)->second;
+    for (int key : absent) tree_sum += tree_map.contains(key);
+    auto middle = std::chrono::steady_clock::now();
+    size_t calls = 0;
+    s21::unordered_map<int, int, std::hash<int>, CountingEqual> hash_map(
+        0, std::hash<int>(), CountingEqual{&calls});
+    for (int key : present) hash_map[key] = key;
+    long hash_sum = 0;
+    calls = 0;
+    for (int key : present) hash_sum += hash_map.find(key)->second;
+    size_t hit_calls = calls;
+    calls = 0;
+    for (int key : absent) hash_sum += hash_map.contains(key);
+    size_t miss_calls = calls;
+    auto stop = std::chrono::steady_clock::now();
+    ASSERT_EQ(tree_sum, hash_sum);
+    auto ns = [keys](auto duration) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                 .count() /
+             (3 * keys);
+    };
+    std::cout << "[ BENCH    ] " << keys << " keys, s21::map: "
+              << ns(middle - start) << " ns/op, unordered_map: "
+              << ns(stop - middle) << " ns/op, key compares per hit "
+              << static_cast<double>(hit_calls) / keys << ", per miss "
+              << static_cast<double>(miss_calls) / keys << std::endl;
+    // a key is compared only when its 7 control bits match, 1 slot in
+    // 128, so a probe of a 16-slot group rarely compares at all
+    EXPECT_LT(hit_calls, keys + keys / 20U);
+    EXPECT_LT(miss_calls, keys / 4U);
+  }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+template <typename Set, typename Expected>
+void ExpectSameKeys(const Set &my_set, const Expected &expected) {
+  ASSERT_EQ(my_set.size(), expected.size());
+  size_t visited = 0;
+  for (const auto &key : my_set) {
+    ASSERT_EQ(expected.count(key), 1U);
+    ++visited;
+  }
+  ASSERT_EQ(visited, expected.size());
+}
+
+}  // namespace
+
+TEST(UnorderedSet, DefaultConstructor) {
+  s21::unordered_set<int> my_set;
+  EXPECT_TRUE(my_set.empty());
+  EXPECT_TRUE(my_set.begin() == my_set.end());
+  EXPECT_FALSE(my_set.contains(0));
+  EXPECT_THROW(my_set.erase(my_set.end()), std::out_of_range);
+}
+
+TEST(UnorderedSet, InsertEraseLookup) {
+  s21::unordered_set<std::string> my_set = {"a", "b", "a", "c"};
+  ExpectSameKeys(my_set, std::set<std::string>{"a", "b", "c"});
+  EXPECT_FALSE(my_set.insert("b").second);
+  EXPECT_TRUE(my_set.emplace(2, 'd').second);
+  EXPECT_EQ(*my_set.find("dd"), "dd");
+  EXPECT_EQ(my_set.count("c"), 1U);
+  EXPECT_EQ(my_set.erase("c"), 1U);
+  EXPECT_EQ(my_set.erase("c"), 0U);
+  my_set.erase(my_set.find("a"));
+  ExpectSameKeys(my_set, std::set<std::string>{"b", "dd"});
+}
+
+TEST(UnorderedSet, RandomOperationsMatchStdSet) {
+  s21::unordered_set<int> my_set;
+  std::set<int> expected;
+  unsigned seed = 5;
+  for (int step = 0; step < 10000; ++step) {
+    seed = seed * 1103515245U + 12345U;
+    int key = static_cast<int>((seed >> 8) % 1000);
+    if ((seed >> 4) % 2 == 0) {
+      ASSERT_EQ(my_set.erase(key), expected.erase(key));
+    } else {
+      ASSERT_EQ(my_set.insert(key).second, expected.insert(key).second);
+    }
+  }
+  ExpectSameKeys(my_set, expected);
+}
+
+TEST(UnorderedSet, SwapMergeAndRehash) {
+  s21::unordered_set<int> my_set = {1, 2, 3};
+  s21::unordered_set<int> other = {3, 4};
+  my_set.merge(other);
+  ExpectSameKeys(my_set, std::set<int>{1, 2, 3, 4});
+  ExpectSameKeys(other, std::set<int>{3});
+  my_set.swap(other);
+  EXPECT_EQ(my_set.size(), 1U);
+  other.reserve(1000);
+  EXPECT_GE(other.bucket_count() * other.max_load_factor(), 1000U);
+  other.rehash(0);
+  EXPECT_LT(other.bucket_count(), 100U);
+  ExpectSameKeys(other, std::set<int>{1, 2, 3, 4});
+}
@@ -3,7 +3,12 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iterator>
+#include <sstream>
+
 #include "vector"
+#include "s21_counting_allocator.h"
 
 #define s21_EPS 1e-7
 
@@ -807,3 +812,510 @@ TEST(TestVector, AtFromEmpty) {
   EXPECT_THROW(std_vec.at(0), std::out_of_range);
   EXPECT_THROW(std_vec.at(1), std::out_of_range);
 }
+
+// raw storage: only live elements are constructed and destroyed
+struct TrackedRecord {
+  static inline int constructed = 0;
+  static inline int destroyed = 0;
+  static void Reset() { constructed = destroyed = 0; }
+
+  explicit TrackedRecord(int v) : value(v) { ++constructed; }
+  TrackedRecord(const TrackedRecord& other) : value(other.value) {
+    ++constructed;
+  }
+  TrackedRecord(TrackedRecord&& other) noexcept : value(other.value) {
+    ++constructed;
+  }
+  TrackedRecord& operator=(const TrackedRecord&) = default;
+  TrackedRecord& operator=(TrackedRecord&&) = default;
+  ~TrackedRecord() { ++destroyed; }
+
+  int value;
+};
+
+TEST(VectorStorage, ReserveConstructsNothing) {
+  TrackedRecord::Reset();
+  {
+    s21::Vector<TrackedRecord> vec;
+    vec.reserve(1000000);
+    EXPECT_EQ(vec.capacity(), 1000000U);
+    EXPECT_EQ(vec.size(), 0U);
+    EXPECT_EQ(TrackedRecord::constructed, 0);
+  }
+  EXPECT_EQ(TrackedRecord::destroyed, 0);
+}
+
+TEST(VectorStorage, NonDefaultConstructible) {
+  TrackedRecord::Reset();
+  {
+    s21::Vector<TrackedRecord> vec;
+    for (int i = 0; i < 100; ++i) vec.push_back(TrackedRecord(i));
+    vec.insert(vec.begin() + 50, TrackedRecord(-1));
+    vec.erase(vec.begin());
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.size(), 100U);
+    EXPECT_EQ(vec.capacity(), 100U);
+    EXPECT_EQ(vec[0].value, 1);
+    EXPECT_EQ(vec[49].value, -1);
+    EXPECT_EQ(vec.back().value, 99);
+
+    s21::Vector<TrackedRecord> copy(vec);
+    EXPECT_EQ(copy.size(), vec.size());
+    EXPECT_EQ(copy[49].value, -1);
+  }
+  EXPECT_EQ(TrackedRecord::constructed, TrackedRecord::destroyed);
+}
+
+TEST(VectorStorage, ClearKeepsCapacity) {
+  s21::Vector<std::string> vec{"a", "b", "c"};
+  vec.clear();
+  EXPECT_EQ(vec.size(), 0U);
+  EXPECT_EQ(vec.capacity(), 3U);
+  vec.push_back("d");
+  EXPECT_EQ(vec.at(0), "d");
+}
+
+TEST(VectorStorage, InsertSelfReference) {
+  s21::Vector<std::string> vec{"a", "b", "c"};
+  vec.insert(vec.begin(), vec[2]);
+  vec.insert(vec.begin() + 1, vec[0]);
+  EXPECT_EQ(vec[0], "c");
+  EXPECT_EQ(vec[1], "c");
+  EXPECT_EQ(vec[4], "c");
+}
+
+TEST(VectorStorage, CopyAssignReusesStorage) {
+  s21::Vector<std::string> vec{"a", "b", "c", "d"};
+  s21::Vector<std::string> small{"x", "y"};
+  auto data = vec.data();
+  vec = small;
+  EXPECT_EQ(vec.data(), data);
+  EXPECT_EQ(vec.size(), 2U);
+  EXPECT_EQ(vec[1], "y");
+}
+
+// move-aware insertion: rvalues and emplaced arguments are never copied
+struct CopyCounter {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  static void Reset() { copies = moves = 0; }
+
+  CopyCounter() = default;
+  explicit CopyCounter(std::string s) : payload(std::move(s)) {}
+  CopyCounter(const CopyCounter& other) : payload(other.payload) { ++copies; }
+  CopyCounter(CopyCounter&& other) noexcept
+      : payload(std::move(other.payload)) {
+    ++moves;
+  }
+  CopyCounter& operator=(const CopyCounter& other) {
+    payload = other.payload;
+    ++copies;
+    return *this;
+  }
+  CopyCounter& operator=(CopyCounter&& other) noexcept {
+    payload = std::move(other.payload);
+    ++moves;
+    return *this;
+  }
+
+  std::string payload;
+};
+
+TEST(VectorInsertion, PushBackRvalue) {
+  s21::Vector<std::string> vec;
+  std::string value(64, 'x');
+  vec.push_back(std::move(value));
+  EXPECT_EQ(vec[0], std::string(64, 'x'));
+  EXPECT_TRUE(value.empty());
+}
+
+TEST(VectorInsertion, EmplaceBack) {
+  s21::Vector<std::pair<int, std::string>> vec;
+  auto& ref = vec.emplace_back(1, "one");
+  EXPECT_EQ(ref.first, 1);
+  vec.emplace_back(2, "two");
+  EXPECT_EQ(vec.size(), 2U);
+  EXPECT_EQ(vec.back().second, "two");
+}
+
+TEST(VectorInsertion, Emplace) {
+  s21::Vector<std::string> vec{"a", "d"};
+  auto it = vec.emplace(vec.begin() + 1, 2, 'b');
+  EXPECT_EQ(*it, "bb");
+  vec.emplace(vec.end(), "e");
+  vec.emplace(vec.begin() + 2, "c");
+  std::vector<std::string> expected{"a", "bb", "c", "d", "e"};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (size_t i = 0; i < vec.size(); ++i) EXPECT_EQ(vec[i], expected[i]);
+}
+
+TEST(VectorInsertion, InsertMany) {
+  s21::Vector<int> vec{1, 5};
+  auto it = vec.insert_many(vec.begin() + 1, 2, 3, 4);
+  EXPECT_EQ(*it, 2);
+  vec.insert_many(vec.begin(), 0);
+  vec.insert_many(vec.end(), 6, 7);
+  ASSERT_EQ(vec.size(), 8U);
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(vec[i], i);
+
+  s21::Vector<int> empty;
+  empty.insert_many(empty.begin(), 1, 2);
+  EXPECT_EQ(empty.size(), 2U);
+  EXPECT_EQ(empty[1], 2);
+}
+
+TEST(VectorInsertion, InsertManyBack) {
+  s21::Vector<std::string> vec{"a"};
+  vec.insert_many_back(vec[0], std::string("b"), "c");
+  ASSERT_EQ(vec.size(), 4U);
+  EXPECT_EQ(vec[1], "a");
+  EXPECT_EQ(vec[3], "c");
+  vec.insert_many_back();
+  EXPECT_EQ(vec.size(), 4U);
+}
+
+TEST(VectorInsertion, CopyCountBenchmark) {
+  const int kCount = 100000;
+  s21::Vector<CopyCounter> vec;
+
+  CopyCounter::Reset();
+  for (int i = 0; i < kCount; ++i) {
+    CopyCounter item("payload");
+    vec.push_back(item);
+  }
+  int lvalue_copies = CopyCounter::copies;
+  EXPECT_EQ(lvalue_copies, kCount);
+
+  vec.clear();
+  CopyCounter::Reset();
+  for (int i = 0; i < kCount; ++i) {
+    vec.push_back(CopyCounter("payload"));
+    vec.emplace_back("payload");
+    vec.insert_many_back(CopyCounter("a"), CopyCounter("b"));
+  }
+  vec.emplace(vec.begin(), "front");
+  vec.insert(vec.begin() + 1, CopyCounter("second"));
+  vec.insert_many(vec.begin() + 2, CopyCounter("x"), CopyCounter("y"));
+  EXPECT_EQ(CopyCounter::copies, 0);
+  std::cout << "[ BENCH    ] " << kCount << " lvalue push_back copies: "
+            << lvalue_copies << ", rvalue/emplace inserts copies: "
+            << CopyCounter::copies << ", moves: " << CopyCounter::moves
+            << std::endl;
+}
+
+// trivially copyable types are relocated and shifted with memmove/memcpy
+struct PodRecord {
+  int id;
+  double weight;
+  char tag[8];
+};
+
+TEST(VectorTrivial, PodInsertErase) {
+  s21::Vector<PodRecord> vec;
+  for (int i = 0; i < 10; ++i) vec.push_back(PodRecord{i, i * 0.5, "pod"});
+  vec.insert(vec.begin() + 3, PodRecord{-1, 0.0, "mid"});
+  vec.insert_many(vec.begin() + 1, PodRecord{-2, 0.0, "a"},
+                  PodRecord{-3, 0.0, "b"});
+  vec.erase(vec.begin());
+  ASSERT_EQ(vec.size(), 12U);
+  EXPECT_EQ(vec[0].id, -2);
+  EXPECT_EQ(vec[1].id, -3);
+  EXPECT_EQ(vec[2].id, 1);
+  EXPECT_EQ(vec[4].id, -1);
+  EXPECT_EQ(vec.back().id, 9);
+  EXPECT_STREQ(vec[4].tag, "mid");
+
+  s21::Vector<PodRecord> copy(vec);
+  s21::Vector<PodRecord> assigned{PodRecord{0, 0.0, ""}};
+  assigned = copy;
+  for (size_t i = 0; i < vec.size(); ++i) {
+    EXPECT_EQ(copy[i].id, vec[i].id);
+    EXPECT_EQ(assigned[i].id, vec[i].id);
+  }
+}
+
+TEST(VectorTrivial, InsertManySelfReference) {
+  s21::Vector<int> vec{1, 2, 3};
+  vec.insert_many(vec.begin(), vec[2], vec[1]);
+  std::vector<int> expected{3, 2, 1, 2, 3};
+  ASSERT_EQ(vec.size(), expected.size());
+  for (size_t i = 0; i < vec.size(); ++i) EXPECT_EQ(vec[i], expected[i]);
+}
+
+TEST(VectorTrivial, MidInsertEraseBenchmark) {
+  const int kSize = 1000000;
+  const int kOps = 50;
+  s21::Vector<int> vec;
+  vec.reserve(kSize + kOps);
+  for (int i = 0; i < kSize; ++i) vec.push_back(i);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kOps; ++i) vec.insert(vec.begin() + kSize / 2, -i);
+  for (int i = 0; i < kOps; ++i) vec.erase(vec.begin() + kSize / 2);
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  ASSERT_EQ(vec.size(), static_cast<size_t>(kSize));
+  for (int i = 0; i < kSize; i += 9973) EXPECT_EQ(vec[i], i);
+  EXPECT_EQ(vec[kSize / 2], kSize / 2);
+  std::cout << "[ BENCH    ] " << 2 * kOps << " mid insert/erase on " << kSize
+            << " ints: " << elapsed.count() << " us" << std::endl;
+}
+
+// range and bulk operations
+template <typename V>
+void ExpectSameElements(const V& vec,
+                        const std::vector<std::string>& expected) {
+  ASSERT_EQ(vec.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) EXPECT_EQ(vec[i], expected[i]);
+}
+
+TEST(VectorBulk, InsertRange) {
+  std::vector<std::string> source{"x", "y", "z"};
+  for (size_t reserve : {0U, 16U}) {
+    for (size_t index = 0; index <= 4; ++index) {
+      s21::Vector<std::string> vec{"a", "b", "c", "d"};
+      std::vector<std::string> expected{"a", "b", "c", "d"};
+      vec.reserve(reserve);
+      auto it = vec.insert(vec.begin() + index, source.begin(), source.end());
+      expected.insert(expected.begin() + index, source.begin(), source.end());
+      EXPECT_EQ(*it, "x");
+      ExpectSameElements(vec, expected);
+    }
+  }
+}
+
+TEST(VectorBulk, InsertRangeTrivial) {
+  s21::Vector<int> vec{1, 2, 6};
+  vec.reserve(10);
+  int source[] = {3, 4, 5};
+  vec.insert(vec.begin() + 2, source, source + 3);
+  vec.insert(vec.end(), {7, 8});
+  ASSERT_EQ(vec.size(), 8U);
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(vec[i], i + 1);
+}
+
+TEST(VectorBulk, InsertInputRange) {
+  std::istringstream input("3 4 5");
+  s21::Vector<int> vec{1, 2, 6};
+  vec.insert(vec.begin() + 2, std::istream_iterator<int>(input),
+             std::istream_iterator<int>());
+  ASSERT_EQ(vec.size(), 6U);
+  for (int i = 0; i < 6; ++i) EXPECT_EQ(vec[i], i + 1);
+}
+
+TEST(VectorBulk, InsertCount) {
+  s21::Vector<std::string> vec{"a", "b"};
+  vec.insert(vec.begin() + 1, 3, vec[1]);
+  ExpectSameElements(vec, {"a", "b", "b", "b", "b"});
+  vec.insert(vec.end(), 0, "c");
+  EXPECT_EQ(vec.size(), 5U);
+
+  s21::Vector<int> ints;
+  ints.insert(ints.begin(), 4U, 7);
+  EXPECT_EQ(ints.size(), 4U);
+  EXPECT_EQ(ints[3], 7);
+}
+
+TEST(VectorBulk, EraseRange) {
+  s21::Vector<std::string> vec{"a", "b", "c", "d", "e"};
+  auto it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+  EXPECT_EQ(*it, "d");
+  ExpectSameElements(vec, {"a", "d", "e"});
+  vec.erase(vec.begin(), vec.begin());
+  EXPECT_EQ(vec.size(), 3U);
+  vec.erase(vec.begin(), vec.end());
+  EXPECT_TRUE(vec.empty());
+}
+
+TEST(VectorBulk, Assign) {
+  s21::Vector<std::string> vec{"a", "b"};
+  vec.assign(3, "z");
+  ExpectSameElements(vec, {"z", "z", "z"});
+  std::vector<std::string> source{"q", "w"};
+  vec.assign(source.begin(), source.end());
+  ExpectSameElements(vec, source);
+  EXPECT_EQ(vec.capacity(), 3U);
+  vec.assign({"1", "2", "3", "4"});
+  ExpectSameElements(vec, {"1", "2", "3", "4"});
+
+  s21::Vector<int> filled(3U, 5);
+  EXPECT_EQ(filled.size(), 3U);
+  EXPECT_EQ(filled[2], 5);
+  s21::Vector<std::string> ranged(source.begin(), source.end());
+  ExpectSameElements(ranged, source);
+}
+
+TEST(VectorBulk, Resize) {
+  s21::Vector<std::string> vec{"a", "b"};
+  vec.resize(4);
+  ExpectSameElements(vec, {"a", "b", "", ""});
+  vec.resize(1);
+  ExpectSameElements(vec, {"a"});
+  vec.resize(3, "c");
+  ExpectSameElements(vec, {"a", "c", "c"});
+
+  s21::Vector<int> ints;
+  ints.resize(5);
+  EXPECT_EQ(ints.size(), 5U);
+  EXPECT_EQ(ints[4], 0);
+}
+
+TEST(VectorBulk, SpliceChunkBenchmark) {
+  const int kChunk = 100000;
+  s21::Vector<CopyCounter> vec;
+  for (int i = 0; i < 4; ++i) vec.emplace_back("base");
+  std::vector<CopyCounter> chunk(kChunk, CopyCounter("chunk"));
+
+  CopyCounter::Reset();
+  auto start = std::chrono::steady_clock::now();
+  vec.insert(vec.begin() + 2, chunk.begin(), chunk.end());
+  vec.erase(vec.begin() + 1, vec.begin() + 1 + kChunk / 2);
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  EXPECT_EQ(vec.size(), static_cast<size_t>(kChunk / 2 + 4));
+  EXPECT_EQ(CopyCounter::copies, kChunk);
+  EXPECT_LE(CopyCounter::moves, kChunk);
+  std::cout << "[ BENCH    ] splice + erase of " << kChunk
+            << " records: " << CopyCounter::copies << " copies, "
+            << CopyCounter::moves << " moves, " << elapsed.count() << " us"
+            << std::endl;
+}
+
+// growth policies
+template <typename Policy>
+std::pair<size_t, size_t> GrowthRun(size_t count, size_t* capacity) {
+  s21::Vector<int, s21::growth::Counted<Policy>> vec;
+  for (size_t i = 0; i < count; ++i) vec.push_back(static_cast<int>(i));
+  *capacity = vec.capacity();
+  return {vec.growth_policy().reallocations(),
+          vec.growth_policy().bytes_moved()};
+}
+
+TEST(VectorGrowth, DefaultDoubles) {
+  s21::Vector<int> vec;
+  std::vector<size_t> capacities;
+  for (int i = 0; i < 9; ++i) {
+    vec.push_back(i);
+    capacities.push_back(vec.capacity());
+  }
+  std::vector<size_t> expected{1, 2, 4, 4, 8, 8, 8, 8, 16};
+  EXPECT_EQ(capacities, expected);
+  EXPECT_EQ(sizeof(vec), 3 * sizeof(void*));
+}
+
+TEST(VectorGrowth, Factor15) {
+  s21::Vector<int, s21::growth::Counted<s21::growth::Factor15>> vec;
+  for (int i = 0; i < 10; ++i) vec.push_back(i);
+  EXPECT_EQ(vec.capacity(), 11U);
+  EXPECT_EQ(vec.growth_policy().reallocations(), 5U);
+  EXPECT_EQ(vec.growth_policy().bytes_moved(), (1 + 2 + 4 + 7) * sizeof(int));
+}
+
+TEST(VectorGrowth, FixedChunk) {
+  s21::Vector<int, s21::growth::FixedChunk<100>> vec;
+  vec.push_back(1);
+  EXPECT_EQ(vec.capacity(), 100U);
+  for (int i = 0; i < 100; ++i) vec.push_back(i);
+  EXPECT_EQ(vec.capacity(), 200U);
+  vec.insert(vec.end(), 150U, 7);
+  EXPECT_EQ(vec.capacity(), 300U);
+}
+
+TEST(VectorGrowth, PageAligned) {
+  s21::Vector<double, s21::growth::PageAligned<>> vec;
+  vec.push_back(1.0);
+  EXPECT_EQ(vec.capacity() * sizeof(double), 4096U);
+  for (int i = 0; i < 600; ++i) vec.push_back(i);
+  EXPECT_EQ(vec.capacity() * sizeof(double) % 4096, 0U);
+  EXPECT_GE(vec.capacity(), vec.size());
+}
+
+TEST(VectorGrowth, CountedCopyAndSwap) {
+  s21::Vector<int, s21::growth::Counted<>> vec{1, 2};
+  vec.push_back(3);
+  s21::Vector<int, s21::growth::Counted<>> copy(vec);
+  EXPECT_EQ(vec.growth_policy().reallocations(), 1U);
+  EXPECT_EQ(copy.growth_policy().reallocations(), 0U);
+  copy.swap(vec);
+  EXPECT_EQ(copy.growth_policy().reallocations(), 1U);
+  vec = copy;
+  EXPECT_EQ(vec.growth_policy().reallocations(), 0U);
+  EXPECT_EQ(vec.size(), 3U);
+}
+
+TEST(VectorGrowth, CountedMove) {
+  using CountedVector = s21::Vector<int, s21::growth::Counted<>>;
+  CountedVector grown;
+  for (int i = 0; i < 5; ++i) grown.push_back(i);  // 1, 2, 4, 8 slots
+  CountedVector moved(std::move(grown));
+  EXPECT_EQ(moved.growth_policy().reallocations(), 4U);
+  CountedVector assigned{1, 2};
+  assigned.push_back(3);
+  EXPECT_EQ(assigned.growth_policy().reallocations(), 1U);
+  // the counters follow the buffer, as for the move constructor and swap
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.growth_policy().reallocations(), 4U);
+  EXPECT_EQ(assigned.growth_policy().bytes_moved(),
+            (1U + 2U + 4U) * sizeof(int));
+  EXPECT_EQ(assigned.size(), 5U);
+}
+
+TEST(VectorGrowth, PolicyBenchmark) {
+  const size_t kCount = 1000000;
+  size_t capacity = 0;
+  auto twice = GrowthRun<s21::growth::Double>(kCount, &capacity);
+  std::cout << "[ BENCH    ] factor 2:   " << twice.first << " reallocations, "
+            << twice.second << " bytes moved, slack " << capacity - kCount
+            << std::endl;
+  EXPECT_GE(capacity, kCount);
+  auto factor15 = GrowthRun<s21::growth::Factor15>(kCount, &capacity);
+  std::cout << "[ BENCH    ] factor 1.5: " << factor15.first
+            << " reallocations, " << factor15.second << " bytes moved, slack "
+            << capacity - kCount << std::endl;
+  EXPECT_LE(capacity - kCount, kCount / 2);
+  auto chunk = GrowthRun<s21::growth::FixedChunk<65536>>(kCount, &capacity);
+  std::cout << "[ BENCH    ] chunk 64k:  " << chunk.first << " reallocations, "
+            << chunk.second << " bytes moved, slack " << capacity - kCount
+            << std::endl;
+  EXPECT_LT(capacity - kCount, 65536U);
+  auto paged = GrowthRun<s21::growth::PageAligned<>>(kCount, &capacity);
+  std::cout << "[ BENCH    ] paged 1.5:  " << paged.first << " reallocations, "
+            << paged.second << " bytes moved, slack " << capacity - kCount
+            << std::endl;
+  EXPECT_EQ(capacity * sizeof(int) % 4096, 0U);
+  EXPECT_LT(twice.first, factor15.first);
+  EXPECT_GT(chunk.second, factor15.second);
+}
+
+TEST(VectorAllocator, RoutesStorageThroughAllocator) {
+  s21_test::CountingAllocator<int> alloc;
+  auto stats = alloc.stats();
+  {
+    s21::Vector<int, s21::growth::Double, s21_test::CountingAllocator<int>>
+        vec(alloc);
+    for (int i = 0; i < 100; ++i) vec.push_back(i);
+    EXPECT_EQ(vec.get_allocator(), alloc);
+    EXPECT_GT(stats->allocations, 0U);
+    EXPECT_EQ(stats->live_objects, vec.capacity());
+  }
+  EXPECT_EQ(stats->allocations, stats->deallocations);
+  EXPECT_EQ(stats->live_objects, 0U);
+}
+
+TEST(VectorAllocator, PropagatesOnMoveAndSwap) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  Alloc first;
+  Alloc second;
+  s21::Vector<int, s21::growth::Double, Alloc> a({1, 2, 3}, first);
+  s21::Vector<int, s21::growth::Double, Alloc> b({4, 5}, second);
+  a.swap(b);
+  EXPECT_EQ(a.get_allocator(), second);
+  EXPECT_EQ(b.get_allocator(), first);
+  EXPECT_EQ(a.size(), 2U);
+  a = std::move(b);
+  EXPECT_EQ(a.get_allocator(), first);
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(second.stats()->live_objects, 0U);
+}
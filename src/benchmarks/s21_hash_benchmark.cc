@@ -0,0 +1,73 @@
+/* Lookup latency of s21::unordered_map near its growth threshold.
+ * Built twice by `make bench_hash`: with the SSE2 group matcher and with
+ * -DS21_HASH_PORTABLE_GROUP, so the two can be compared side by side */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+namespace {
+
+constexpr std::size_t kBuckets = (1U << 20) - 1;
+constexpr int kRounds = 5;
+
+template <typename Lookup>
+double ns_per_lookup(const std::vector<int> &keys, long *sink,
+                     Lookup lookup) {
+  double best = 0;
+  for (int round = 0; round < kRounds; ++round) {
+    auto start = std::chrono::steady_clock::now();
+    for (int key : keys) *sink += lookup(key);
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() /
+                static_cast<double>(keys.size());
+    if (round == 0 || ns < best) best = ns;
+  }
+  return best;
+}
+
+}  // namespace
+
+int main() {
+#ifdef S21_HASH_SSE2_GROUP
+  const char *group = "sse2";
+#else
+  const char *group = "portable";
+#endif
+  long sink = 0;
+  for (float load : {0.5f, 0.75f, 0.875f, 0.95f}) {
+    s21::unordered_map<int, int> table;
+    table.max_load_factor(load);
+    table.rehash(kBuckets);
+    // fill up to the growth threshold without crossing it
+    std::size_t count = static_cast<std::size_t>(
+                            static_cast<double>(table.bucket_count()) * load) -
+                        1;
+    std::vector<int> present(count), absent(count);
+    unsigned seed = 2024;
+    for (std::size_t i = 0; i < count; ++i) {
+      seed = seed * 1103515245U + 12345U;
+      present[i] = static_cast<int>(seed >> 1) | 1;
+      absent[i] = present[i] - 1;  // even keys are never inserted
+    }
+    for (int key : present) table[key] = key;
+    // lookups in a different order than the inserts
+    for (std::size_t i = count - 1; i > 0; --i) {
+      seed = seed * 1103515245U + 12345U;
+      std::swap(present[i], present[seed % (i + 1)]);
+    }
+    double hit = ns_per_lookup(present, &sink, [&table](int key) {
+      return table.find(key)->second;
+    });
+    double miss = ns_per_lookup(absent, &sink, [&table](int key) {
+      return static_cast<int>(table.contains(key));
+    });
+    std::printf("%-8s load %.3f (%zu keys in %zu slots): hit %6.1f ns, "
+                "miss %6.1f ns\n",
+                group, static_cast<double>(table.load_factor()), table.size(),
+                table.bucket_count(), hit, miss);
+  }
+  return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+#ifndef CPP2_S21_CONTAINERS_1_FLAT_FLAT_SEARCH_H
+#define CPP2_S21_CONTAINERS_1_FLAT_FLAT_SEARCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace s21 {
+namespace flat {
+
+/* Binary search over the sorted keys of flat_map and flat_set. For
+ * arithmetic keys the loop halves the range without a data-dependent
+ * branch: the step is picked with a conditional move, so the loop runs
+ * exactly log2(count) times and never mispredicts. Other keys use
+ * std::lower_bound, which can stop comparing expensive keys early. */
+
+/* Index of the first of count sorted keys that is not less than key */
+template <typename Key, typename K, typename Compare>
+std::size_t lower_index(const Key *first, std::size_t count, const K &key,
+                        const Compare &comp) {
+  if constexpr (std::is_arithmetic_v<Key>) {
+    if (count == 0) return 0;
+    const Key *base = first;
+    while (count > 1) {
+      std::size_t half = count / 2;
+      base = comp(base[half], key) ? base + half : base;
+      count -= half;
+    }
+    return static_cast<std::size_t>(base - first) + comp(*base, key);
+  } else {
+    return static_cast<std::size_t>(
+        std::lower_bound(first, first + count, key, comp) - first);
+  }
+}
+
+/* Index of the first of count sorted keys that is greater than key */
+template <typename Key, typename K, typename Compare>
+std::size_t upper_index(const Key *first, std::size_t count, const K &key,
+                        const Compare &comp) {
+  if constexpr (std::is_arithmetic_v<Key>) {
+    if (count == 0) return 0;
+    const Key *base = first;
+    while (count > 1) {
+      std::size_t half = count / 2;
+      base = comp(key, base[half]) ? base : base + half;
+      count -= half;
+    }
+    return static_cast<std::size_t>(base - first) + !comp(key, *base);
+  } else {
+    return static_cast<std::size_t>(
+        std::upper_bound(first, first + count, key, comp) - first);
+  }
+}
+
+}  // namespace flat
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_FLAT_FLAT_SEARCH_H
@@ -0,0 +1,137 @@
+#ifndef CPP2_S21_CONTAINERS_1_HASH_HASH_GROUP_H
+#define CPP2_S21_CONTAINERS_1_HASH_HASH_GROUP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) && !defined(S21_HASH_PORTABLE_GROUP)
+#define S21_HASH_SSE2_GROUP 1
+#include <emmintrin.h>
+#endif
+
+namespace s21 {
+namespace hash {
+
+/* Control byte of a slot: the low 7 bits of the hash when the slot is
+ * full, or one of the negative markers below */
+using ctrl_t = signed char;
+
+constexpr ctrl_t kEmpty = -128;
+constexpr ctrl_t kDeleted = -2;
+/* Follows the last slot, stops iteration */
+constexpr ctrl_t kSentinel = -1;
+
+inline bool is_full(ctrl_t c) noexcept { return c >= 0; }
+inline bool is_empty_or_deleted(ctrl_t c) noexcept { return c < kSentinel; }
+
+/* Set of slot positions inside a group, bit i stands for slot i */
+class BitMask {
+ public:
+  explicit BitMask(std::uint32_t mask) noexcept : mask_(mask) {}
+
+  explicit operator bool() const noexcept { return mask_ != 0; }
+
+  /* Index of the first position; the mask must not be empty */
+  std::size_t lowest() const noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctz(mask_));
+#else
+    std::size_t index = 0;
+    while (!(mask_ >> index & 1U)) ++index;
+    return index;
+#endif
+  }
+
+  /* Number of positions before the first one in the mask */
+  std::size_t trailing_zeros(std::size_t width) const noexcept {
+    return mask_ ? lowest() : width;
+  }
+
+  /* Number of positions after the last one in the mask */
+  std::size_t leading_zeros(std::size_t width) const noexcept {
+    std::size_t count = 0;
+    while (count < width && !(mask_ >> (width - 1 - count) & 1U)) ++count;
+    return count;
+  }
+
+  /* Drops the lowest position, for iterating over the matches */
+  BitMask &operator++() noexcept {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+
+ private:
+  std::uint32_t mask_;
+};
+
+/* Control bytes of kWidth consecutive slots, the unit of one probe step.
+ * Every mask is computed with a plain loop over the bytes; this is the
+ * fallback for targets without SSE2 and for S21_HASH_PORTABLE_GROUP
+ * builds */
+struct GroupPortable {
+  static constexpr std::size_t kWidth = 16;
+
+  explicit GroupPortable(const ctrl_t *pos) noexcept {
+    std::memcpy(ctrl, pos, kWidth);
+  }
+
+  /* Slots whose control byte is h2 */
+  BitMask match(ctrl_t h2) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+    }
+    return BitMask(mask);
+  }
+
+  BitMask match_empty() const noexcept { return match(kEmpty); }
+
+  BitMask match_empty_or_deleted() const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(is_empty_or_deleted(ctrl[i])) << i;
+    }
+    return BitMask(mask);
+  }
+
+  ctrl_t ctrl[kWidth];
+};
+
+#ifdef S21_HASH_SSE2_GROUP
+/* The same group in one SSE2 register: a match is one byte-wise compare
+ * of all 16 control bytes and a movemask of the result */
+struct GroupSse2 {
+  static constexpr std::size_t kWidth = 16;
+
+  explicit GroupSse2(const ctrl_t *pos) noexcept
+      : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+  BitMask match(ctrl_t h2) const noexcept {
+    return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+  }
+
+  BitMask match_empty() const noexcept { return match(kEmpty); }
+
+  /* Control bytes are signed, so one compare finds every byte below the
+   * sentinel */
+  BitMask match_empty_or_deleted() const noexcept {
+    return to_mask(_mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl));
+  }
+
+  static BitMask to_mask(__m128i bytes) noexcept {
+    return BitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(bytes)));
+  }
+
+  __m128i ctrl;
+};
+
+using Group = GroupSse2;
+#else
+using Group = GroupPortable;
+#endif
+
+}  // namespace hash
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_HASH_HASH_GROUP_H
@@ -0,0 +1,605 @@
+#ifndef CPP2_S21_CONTAINERS_1_HASH_HASH_TABLE_H
+#define CPP2_S21_CONTAINERS_1_HASH_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../s21_allocator.h"
+#include "../s21_keys.h"
+#include "hash_group.h"
+
+namespace s21 {
+
+/* Position of a full slot: its control byte and its value. Iteration walks
+ * the control bytes and stops at the sentinel after the last slot */
+template <typename Value, bool Const>
+class HashIterator {
+  using ctrl_t = hash::ctrl_t;
+  using slot_ptr = std::conditional_t<Const, const Value *, Value *>;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Value;
+  using difference_type = std::ptrdiff_t;
+  using pointer = slot_ptr;
+  using reference = std::conditional_t<Const, const Value &, Value &>;
+
+  HashIterator() = default;
+  /* Moves on to the first full slot at or after the given one */
+  HashIterator(const ctrl_t *ctrl, slot_ptr slot) noexcept
+      : ctrl_(ctrl), slot_(slot) {
+    skip_free_slots();
+  }
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  HashIterator(const HashIterator<Value, OtherConst> &other) noexcept
+      : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+  reference operator*() const noexcept { return *slot_; }
+  pointer operator->() const noexcept { return slot_; }
+
+  HashIterator &operator++() noexcept {
+    ++ctrl_;
+    ++slot_;
+    skip_free_slots();
+    return *this;
+  }
+  HashIterator operator++(int) noexcept {
+    HashIterator n = *this;
+    ++*this;
+    return n;
+  }
+
+  friend bool operator==(const HashIterator &a,
+                         const HashIterator &b) noexcept {
+    return a.ctrl_ == b.ctrl_;
+  }
+  friend bool operator!=(const HashIterator &a,
+                         const HashIterator &b) noexcept {
+    return a.ctrl_ != b.ctrl_;
+  }
+
+ private:
+  template <typename, typename, typename, typename, typename, typename>
+  friend class hash_table;
+  template <typename, bool>
+  friend class HashIterator;
+
+  void skip_free_slots() noexcept {
+    while (ctrl_ && hash::is_empty_or_deleted(*ctrl_)) {
+      ++ctrl_;
+      ++slot_;
+    }
+  }
+
+  const ctrl_t *ctrl_ = nullptr;
+  slot_ptr slot_ = nullptr;
+};
+
+/* Open-addressing hash table shared by unordered_map and unordered_set,
+ * laid out as a Swiss table: values live in one flat slot array, and a
+ * parallel array holds one control byte per slot with 7 bits of the hash
+ * of a full slot. A lookup probes the control bytes a Group at a time and
+ * compares keys only in the slots whose byte matches, so almost every
+ * comparison is a hit.
+ *
+ * The capacity is 2^k - 1 slots. Control bytes are followed by a sentinel
+ * and by copies of the first Group::kWidth - 1 bytes, so a group can be
+ * read at any slot without wrapping around. Groups are probed
+ * quadratically, which visits every group of such a table. Erased slots
+ * become tombstones unless no probe can have passed them, and rehashing
+ * drops the tombstones.
+ *
+ * Rehashing moves the values, so it invalidates iterators and references,
+ * and the arguments of an insertion must not refer to elements of the same
+ * table. */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+class hash_table {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = HashIterator<Value, false>;
+  using const_iterator = HashIterator<Value, true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+ protected:
+  using ctrl_t = hash::ctrl_t;
+  using Group = hash::Group;
+  using value_traits = std::allocator_traits<Allocator>;
+  using ctrl_allocator =
+      typename value_traits::template rebind_alloc<hash::ctrl_t>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+  static constexpr size_type kWidth = Group::kWidth;
+  static constexpr size_type kMinCapacity = kWidth - 1;
+
+  /* Where find_insert_position found the key, or the free slot a value
+   * with that key goes to together with its control byte */
+  struct InsertPosition {
+    size_type index;
+    ctrl_t h2;
+    bool found;
+  };
+
+ public:
+  hash_table() : hash_table(Allocator()) {}
+  explicit hash_table(const Allocator &alloc)
+      : hash_table(0, Hash(), KeyEqual(), alloc) {}
+  explicit hash_table(size_type bucket_count, const Hash &hash = Hash(),
+                      const KeyEqual &equal = KeyEqual(),
+                      const Allocator &alloc = Allocator())
+      : holder_(alloc), hash_(hash), equal_(equal) {
+    if (bucket_count) rehash(bucket_count);
+  }
+
+  hash_table(const hash_table &other)
+      : holder_(value_traits::select_on_container_copy_construction(
+            other.holder_.GetAllocator())),
+        hash_(other.hash_),
+        equal_(other.equal_),
+        max_load_(other.max_load_) {
+    copy_from(other);
+  }
+
+  hash_table(hash_table &&other) noexcept
+      : holder_(other.holder_.GetAllocator()),
+        hash_(other.hash_),
+        equal_(other.equal_),
+        max_load_(other.max_load_) {
+    steal(other);
+  }
+
+  ~hash_table() { release(); }
+
+  hash_table &operator=(const hash_table &other) {
+    if (this != &other) {
+      release();
+      holder_.CopyAssignAllocator(other.holder_);
+      hash_ = other.hash_;
+      equal_ = other.equal_;
+      max_load_ = other.max_load_;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  hash_table &operator=(hash_table &&other) noexcept(
+      value_traits::propagate_on_container_move_assignment::value ||
+      value_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    release();
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    max_load_ = other.max_load_;
+    if (value_traits::propagate_on_container_move_assignment::value ||
+        holder_.SameAllocator(other.holder_)) {
+      holder_.MoveAssignAllocator(other.holder_);
+      steal(other);
+    } else {
+      reserve(other.size());
+      for (value_type &value : other) insert(std::move(value));
+      other.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return holder_.GetAllocator();
+  }
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+
+  /* Iterators */
+
+  iterator begin() noexcept { return iterator(ctrl_, slots_); }
+  iterator end() noexcept { return iterator_at(capacity_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(ctrl_, slots_);
+  }
+  const_iterator end() const noexcept { return iterator_at(capacity_); }
+
+  /* Capacity */
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+  [[nodiscard]] size_type max_size() const noexcept {
+    return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+  }
+
+  /* Hash policy */
+
+  size_type bucket_count() const noexcept { return capacity_; }
+  float load_factor() const noexcept {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+  }
+  float max_load_factor() const noexcept { return max_load_; }
+
+  /* Share of the slots that may be full or tombstones before the table
+   * grows, in (0, 1]. At least one slot always stays empty, which ends
+   * every probe for a missing key */
+  void max_load_factor(float load) {
+    if (!(load > 0.0f && load <= 1.0f)) {
+      throw std::invalid_argument("max_load_factor must be in (0, 1]");
+    }
+    max_load_ = load;
+    if (capacity_) rehash(0);
+  }
+
+  /* Makes room for count elements without further rehashing */
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) resize(capacity_for(count));
+  }
+
+  /* Resizes to at least count slots and to at least what size() needs,
+   * dropping tombstones; rehash(0) shrinks the table to fit */
+  void rehash(size_type count) {
+    size_type capacity = capacity_for(size_);
+    while (capacity < count) capacity = capacity * 2 + 1;
+    if (size_ == 0 && count == 0) {
+      release();
+    } else {
+      resize(capacity);
+    }
+  }
+
+  /* Modifiers */
+
+  void clear() noexcept {
+    destroy_values();
+    if (capacity_) reset_ctrl();
+    size_ = 0;
+    growth_left_ = growth_for(capacity_);
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return emplace_at(find_insert_position(key_of(value)), value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return emplace_at(find_insert_position(key_of(value)), std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  /* Returns the element after pos; nothing moves, so the other iterators
+   * stay valid */
+  iterator erase(const_iterator pos) {
+    size_type index = static_cast<size_type>(pos.ctrl_ - ctrl_);
+    erase_at(index);
+    return iterator_at(index);
+  }
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  size_type erase(const Key &key) {
+    size_type index = find_index(key, hash_of(key));
+    if (index == capacity_) return 0;
+    erase_at(index);
+    return 1;
+  }
+
+  void swap(hash_table &other) noexcept {
+    holder_.SwapAllocator(other.holder_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(max_load_, other.max_load_);
+  }
+
+  /* Moves the values of other whose keys are missing here, the duplicates
+   * stay in other */
+  template <typename OtherHash, typename OtherEqual>
+  void merge(hash_table<Key, Value, KeyOfValue, OtherHash, OtherEqual,
+                        Allocator> &other) {
+    if (static_cast<void *>(this) == static_cast<void *>(&other)) return;
+    for (size_type i = 0; i < other.capacity_; ++i) {
+      if (!hash::is_full(other.ctrl_[i])) continue;
+      InsertPosition pos = find_insert_position(key_of(other.slots_[i]));
+      if (!pos.found) {
+        emplace_at(pos, std::move(other.slots_[i]));
+        other.erase_at(i);
+      }
+    }
+  }
+
+  /* Lookup */
+
+  iterator find(const Key &key) {
+    return iterator_at(find_index(key, hash_of(key)));
+  }
+  const_iterator find(const Key &key) const {
+    return iterator_at(find_index(key, hash_of(key)));
+  }
+  [[nodiscard]] bool contains(const Key &key) const {
+    return find_index(key, hash_of(key)) != capacity_;
+  }
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+ protected:
+  template <typename, typename, typename, typename, typename, typename>
+  friend class hash_table;
+
+  static const Key &key_of(const value_type &value) noexcept {
+    return KeyOfValue()(value);
+  }
+
+  /* Spreads the bits of a weak hash such as the identity std::hash of
+   * integers over the whole word: h1 picks the first group, h2 is the
+   * control byte */
+  size_type hash_of(const Key &key) const {
+    std::uint64_t mixed =
+        static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_type>(mixed ^ (mixed >> 32));
+  }
+  static size_type h1(size_type hash) noexcept { return hash >> 7; }
+  static ctrl_t h2(size_type hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+
+  iterator iterator_at(size_type index) noexcept {
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+  const_iterator iterator_at(size_type index) const noexcept {
+    return const_iterator(ctrl_ + index, slots_ + index);
+  }
+
+  /* Slot holding key, or capacity_ if it is missing */
+  size_type find_index(const Key &key, size_type hash) const {
+    if (!capacity_) return capacity_;
+    size_type offset = h1(hash) & capacity_;
+    for (size_type step = kWidth;; step += kWidth) {
+      Group group(ctrl_ + offset);
+      for (hash::BitMask match = group.match(h2(hash)); match; ++match) {
+        size_type index = (offset + match.lowest()) & capacity_;
+        if (equal_(key_of(slots_[index]), key)) return index;
+      }
+      if (group.match_empty()) return capacity_;
+      offset = (offset + step) & capacity_;
+    }
+  }
+
+  /* First empty or deleted slot on the probe sequence of hash */
+  size_type find_free_slot(size_type hash) const noexcept {
+    size_type offset = h1(hash) & capacity_;
+    for (size_type step = kWidth;; step += kWidth) {
+      hash::BitMask free = Group(ctrl_ + offset).match_empty_or_deleted();
+      if (free) return (offset + free.lowest()) & capacity_;
+      offset = (offset + step) & capacity_;
+    }
+  }
+
+  /* One probe sequence either finds key or picks the slot for it, growing
+   * the table first when an empty slot would exceed the load factor */
+  InsertPosition find_insert_position(const Key &key) {
+    size_type hash = hash_of(key);
+    size_type index = find_index(key, hash);
+    if (index != capacity_) return InsertPosition{index, h2(hash), true};
+    if (!capacity_) resize(kMinCapacity);
+    index = find_free_slot(hash);
+    if (growth_left_ == 0 && ctrl_[index] != hash::kDeleted) {
+      grow();
+      index = find_free_slot(hash);
+    }
+    return InsertPosition{index, h2(hash), false};
+  }
+
+  /* Builds a value from args in the slot picked by find_insert_position
+   * unless the key was found there */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_at(const InsertPosition &pos,
+                                       Args &&...args) {
+    if (pos.found) return std::make_pair(iterator_at(pos.index), false);
+    value_traits::construct(holder_.GetAllocator(), slots_ + pos.index,
+                            std::forward<Args>(args)...);
+    growth_left_ -= ctrl_[pos.index] == hash::kEmpty;
+    set_ctrl(pos.index, pos.h2);
+    ++size_;
+    return std::make_pair(iterator_at(pos.index), true);
+  }
+
+  /* A slot can become empty again if every group read over it still had
+   * an empty slot, so no probe sequence ever went past it */
+  void erase_at(size_type index) noexcept {
+    value_traits::destroy(holder_.GetAllocator(), slots_ + index);
+    --size_;
+    size_type before = (index - kWidth) & capacity_;
+    hash::BitMask empty_after = Group(ctrl_ + index).match_empty();
+    hash::BitMask empty_before = Group(ctrl_ + before).match_empty();
+    bool never_full = empty_before && empty_after &&
+                      empty_after.trailing_zeros(kWidth) +
+                              empty_before.leading_zeros(kWidth) <
+                          kWidth;
+    set_ctrl(index, never_full ? hash::kEmpty : hash::kDeleted);
+    growth_left_ += never_full;
+  }
+
+  /* Writes a control byte and its copy past the sentinel */
+  void set_ctrl(size_type index, ctrl_t value) noexcept {
+    ctrl_[index] = value;
+    if (index < kWidth - 1) ctrl_[capacity_ + 1 + index] = value;
+  }
+
+  /* Full slots or tombstones allowed in capacity slots */
+  size_type growth_for(size_type capacity) const noexcept {
+    if (!capacity) return 0;
+    size_type limit = static_cast<size_type>(capacity * max_load_);
+    if (limit >= capacity) limit = capacity - 1;
+    return limit ? limit : 1;
+  }
+
+  /* Smallest capacity 2^k - 1 that holds count elements */
+  size_type capacity_for(size_type count) const noexcept {
+    size_type capacity = kMinCapacity;
+    while (growth_for(capacity) < count) capacity = capacity * 2 + 1;
+    return capacity;
+  }
+
+  /* Doubles the table, or only drops the tombstones when they take up
+   * most of the room */
+  void grow() {
+    if (size_ * 2 <= growth_for(capacity_)) {
+      resize(capacity_);
+    } else {
+      resize(capacity_ * 2 + 1);
+    }
+  }
+
+  /* Moves every value into fresh arrays of new_capacity slots, probing
+   * without comparing keys. If a hash or a copy throws, the old table is
+   * kept */
+  void resize(size_type new_capacity) {
+    ctrl_t *old_ctrl = ctrl_;
+    value_type *old_slots = slots_;
+    size_type old_capacity = capacity_;
+    size_type old_growth = growth_left_;
+    allocate(new_capacity);
+    try {
+      for (size_type i = 0; i < old_capacity; ++i) {
+        if (!hash::is_full(old_ctrl[i])) continue;
+        size_type hash = hash_of(key_of(old_slots[i]));
+        size_type index = find_free_slot(hash);
+        value_traits::construct(holder_.GetAllocator(), slots_ + index,
+                                std::move_if_noexcept(old_slots[i]));
+        set_ctrl(index, h2(hash));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < capacity_; ++i) {
+        if (hash::is_full(ctrl_[i])) {
+          value_traits::destroy(holder_.GetAllocator(), slots_ + i);
+        }
+      }
+      deallocate();
+      ctrl_ = old_ctrl;
+      slots_ = old_slots;
+      capacity_ = old_capacity;
+      growth_left_ = old_growth;
+      throw;
+    }
+    std::swap(ctrl_, old_ctrl);
+    std::swap(slots_, old_slots);
+    std::swap(capacity_, old_capacity);
+    destroy_values();
+    deallocate();
+    ctrl_ = old_ctrl;
+    slots_ = old_slots;
+    capacity_ = old_capacity;
+    growth_left_ = growth_for(capacity_) - size_;
+  }
+
+  /* Gives the table empty arrays of capacity slots, the old ones must be
+   * released by the caller */
+  void allocate(size_type capacity) {
+    ctrl_allocator ctrl_alloc(holder_.GetAllocator());
+    ctrl_t *ctrl = ctrl_traits::allocate(ctrl_alloc, capacity + kWidth);
+    try {
+      slots_ = value_traits::allocate(holder_.GetAllocator(), capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + kWidth);
+      throw;
+    }
+    ctrl_ = ctrl;
+    capacity_ = capacity;
+    reset_ctrl();
+    growth_left_ = growth_for(capacity);
+  }
+
+  void reset_ctrl() noexcept {
+    std::memset(ctrl_, hash::kEmpty, capacity_ + kWidth);
+    ctrl_[capacity_] = hash::kSentinel;
+  }
+
+  void deallocate() noexcept {
+    if (!capacity_) return;
+    ctrl_allocator ctrl_alloc(holder_.GetAllocator());
+    ctrl_traits::deallocate(ctrl_alloc, ctrl_, capacity_ + kWidth);
+    value_traits::deallocate(holder_.GetAllocator(), slots_, capacity_);
+  }
+
+  void destroy_values() noexcept {
+    for (size_type i = 0; i < capacity_ && size_; ++i) {
+      if (hash::is_full(ctrl_[i])) {
+        value_traits::destroy(holder_.GetAllocator(), slots_ + i);
+      }
+    }
+  }
+
+  /* Destroys the values and frees the arrays */
+  void release() noexcept {
+    destroy_values();
+    deallocate();
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = size_ = growth_left_ = 0;
+  }
+
+  void steal(hash_table &other) noexcept {
+    ctrl_ = std::exchange(other.ctrl_, nullptr);
+    slots_ = std::exchange(other.slots_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_ = std::exchange(other.size_, 0);
+    growth_left_ = std::exchange(other.growth_left_, 0);
+  }
+
+  /* Copies the control bytes as they are and every value into the same
+   * slot, no key is hashed */
+  void copy_from(const hash_table &other) {
+    if (!other.size_) return;
+    allocate(other.capacity_);
+    std::memcpy(ctrl_, other.ctrl_, capacity_ + kWidth);
+    size_type i = 0;
+    try {
+      for (; i < capacity_; ++i) {
+        if (hash::is_full(ctrl_[i])) {
+          value_traits::construct(holder_.GetAllocator(), slots_ + i,
+                                  other.slots_[i]);
+        }
+      }
+    } catch (...) {
+      while (i-- > 0) {
+        if (hash::is_full(ctrl_[i])) {
+          value_traits::destroy(holder_.GetAllocator(), slots_ + i);
+        }
+      }
+      deallocate();
+      ctrl_ = nullptr;
+      slots_ = nullptr;
+      capacity_ = growth_left_ = 0;
+      throw;
+    }
+    size_ = other.size_;
+    growth_left_ = other.growth_left_;
+  }
+
+  AllocatorHolder<Allocator> holder_;
+  Hash hash_;
+  KeyEqual equal_;
+  ctrl_t *ctrl_ = nullptr;
+  value_type *slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  size_type growth_left_ = 0;
+  float max_load_ = 0.875f;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_HASH_HASH_TABLE_H
@@ -0,0 +1,60 @@
+#ifndef CPP2_S21_CONTAINERS_1_S21_ALLOCATOR_H
+#define CPP2_S21_CONTAINERS_1_S21_ALLOCATOR_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/* Stores the allocator of a container as an empty base, so stateless
+ * allocators such as std::allocator take no space in the container object.
+ * Containers use allocators for memory only (allocate/deallocate through
+ * std::allocator_traits, rebound to their node type where needed) and
+ * construct elements in that memory themselves. */
+template <typename Allocator>
+class AllocatorHolder : private Allocator {
+ public:
+  using traits = std::allocator_traits<Allocator>;
+
+  AllocatorHolder() noexcept(
+      std::is_nothrow_default_constructible_v<Allocator>) = default;
+  explicit AllocatorHolder(const Allocator &alloc) noexcept
+      : Allocator(alloc) {}
+  explicit AllocatorHolder(Allocator &&alloc) noexcept
+      : Allocator(std::move(alloc)) {}
+
+  Allocator &GetAllocator() noexcept { return *this; }
+  const Allocator &GetAllocator() const noexcept { return *this; }
+
+  /* Applies the propagate_on_container_* rules of std::allocator_traits */
+  void CopyAssignAllocator(const AllocatorHolder &other) {
+    if constexpr (traits::propagate_on_container_copy_assignment::value) {
+      GetAllocator() = other.GetAllocator();
+    }
+  }
+  void MoveAssignAllocator(AllocatorHolder &other) noexcept {
+    if constexpr (traits::propagate_on_container_move_assignment::value) {
+      GetAllocator() = std::move(other.GetAllocator());
+    }
+  }
+  void SwapAllocator(AllocatorHolder &other) noexcept {
+    if constexpr (traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(GetAllocator(), other.GetAllocator());
+    }
+  }
+
+  /* True if memory of other can be released by this allocator */
+  bool SameAllocator(const AllocatorHolder &other) const noexcept {
+    if constexpr (traits::is_always_equal::value) {
+      return true;
+    } else {
+      return GetAllocator() == other.GetAllocator();
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_ALLOCATOR_H
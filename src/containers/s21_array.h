@@ -1,26 +1,34 @@
 #ifndef S21_ARRAY_H
 #define S21_ARRAY_H
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <limits>
+#include <memory>
+
+#include "s21_allocator.h"
 
 namespace s21 {
-template <typename T, size_t S>
-class Array {
+/* Elements live in a buffer of S objects obtained from Allocator */
+template <typename T, size_t S, typename Allocator = std::allocator<T>>
+class Array : private AllocatorHolder<Allocator> {
  public:
   using value_type = T;
   using reference = T&;
   using const_reference = const T&;
   using iterator = const T*;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
-  Array();
+  Array() : Array(allocator_type()) {}
+  explicit Array(const allocator_type& alloc);
   Array(const Array& a);
   Array(Array&& a);
   ~Array();
   Array& operator=(const Array& a);
-  Array(std::initializer_list<value_type> const& items);
+  Array(std::initializer_list<value_type> const& items,
+        const allocator_type& alloc = allocator_type());
   Array& operator=(const Array&& a) noexcept;
   const_reference operator[](size_type pos) const;
   reference operator[](size_type pos);
@@ -36,8 +44,16 @@ class Array {
   bool operator==(const Array& other) const;
   size_type max_size() const noexcept;
   void fill(const_reference value);
+  allocator_type get_allocator() const;
 
  private:
+  using allocator_holder = AllocatorHolder<Allocator>;
+  using allocator_traits = std::allocator_traits<Allocator>;
+  using allocator_holder::GetAllocator;
+
+  value_type* AllocateStorage();
+  void DeallocateStorage() noexcept;
+
   value_type* array;
 };
 }  // namespace s21
@@ -3,59 +3,89 @@
 
 namespace s21 {
 
-template <typename T, size_t S>
-Array<T, S>::Array() {
-  if (S == 0) {
-    array = nullptr;
-  } else {
-    array = new value_type[S]{};
+template <typename T, size_t S, typename Allocator>
+Array<T, S, Allocator>::Array(const allocator_type &alloc)
+    : allocator_holder(alloc), array(AllocateStorage()) {
+  if (array) {
+    try {
+      std::uninitialized_value_construct_n(array, S);
+    } catch (...) {
+      DeallocateStorage();
+      throw;
+    }
   }
 }
 
-template <typename T, size_t S>
-Array<T, S>::Array(const Array &a) {
-  array = new value_type[a.size()];
-  for (size_type i = 0; i < S; ++i) {
-    array[i] = a.array[i];
+template <typename T, size_t S, typename Allocator>
+Array<T, S, Allocator>::Array(const Array &a)
+    : allocator_holder(
+          allocator_traits::select_on_container_copy_construction(
+              a.GetAllocator())),
+      array(AllocateStorage()) {
+  if (array) {
+    try {
+      std::uninitialized_copy_n(a.array, S, array);
+    } catch (...) {
+      DeallocateStorage();
+      throw;
+    }
   }
 }
 
-template <typename T, size_t S>
-Array<T, S>::Array(Array &&a) {
-  array = a.array;
+template <typename T, size_t S, typename Allocator>
+Array<T, S, Allocator>::Array(Array &&a)
+    : allocator_holder(std::move(a.GetAllocator())), array(a.array) {
   a.array = nullptr;
 }
-template <typename T, size_t S>
-typename Array<T, S>::const_reference Array<T, S>::operator[](
-    size_type pos) const {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::const_reference
+Array<T, S, Allocator>::operator[](size_type pos) const {
   return array[pos];
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::reference Array<T, S>::operator[](size_type pos) {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::reference
+Array<T, S, Allocator>::operator[](size_type pos) {
   return array[pos];
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::size_type Array<T, S>::size() const noexcept {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::size_type
+Array<T, S, Allocator>::size() const noexcept {
   return S;
 }
 
-template <typename T, std::size_t S>
-Array<T, S>::Array(const std::initializer_list<value_type> &items)
-    : array(new value_type[S]) {
-  std::copy(items.begin(), items.end(), array);
+template <typename T, std::size_t S, typename Allocator>
+Array<T, S, Allocator>::Array(const std::initializer_list<value_type> &items,
+                              const allocator_type &alloc)
+    : allocator_holder(alloc), array(AllocateStorage()) {
+  if (array) {
+    size_type count = std::min(items.size(), S);
+    try {
+      std::uninitialized_copy_n(items.begin(), count, array);
+    } catch (...) {
+      DeallocateStorage();
+      throw;
+    }
+    try {
+      std::uninitialized_value_construct(array + count, array + S);
+    } catch (...) {
+      std::destroy(array, array + count);
+      DeallocateStorage();
+      throw;
+    }
+  }
 }
 
-template <typename T, size_t S>
-Array<T, S> &Array<T, S>::operator=(const Array &a) {
+template <typename T, size_t S, typename Allocator>
+Array<T, S, Allocator> &Array<T, S, Allocator>::operator=(const Array &a) {
   if (this != &a) {
     std::copy(a.array, a.array + S, array);
   }
   return *this;
 }
-template <typename T, size_t S>
-bool Array<T, S>::operator==(const Array &other) const {
+template <typename T, size_t S, typename Allocator>
+bool Array<T, S, Allocator>::operator==(const Array &other) const {
   bool flag = false;
   for (size_type i = 0; i < S; ++i) {
     if (array[i] != other.array[i]) {
@@ -65,49 +95,53 @@ bool Array<T, S>::operator==(const Array &other) const {
   return flag = true;
 }
 
-template <typename T, size_t S>
-Array<T, S> &Array<T, S>::operator=(const Array &&a) noexcept {
+template <typename T, size_t S, typename Allocator>
+Array<T, S, Allocator> &Array<T, S, Allocator>::operator=(
+    const Array &&a) noexcept {
   for (size_t i = 0; i < S; ++i) {
     array[i] = std::move(a.array[i]);
   }
   return *this;
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::reference Array<T, S>::at(size_type pos) {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::reference
+Array<T, S, Allocator>::at(size_type pos) {
   if (pos >= S) {
     throw std::invalid_argument("Error");
   } else
     return array[pos];
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::iterator Array<T, S>::data() {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::iterator Array<T, S, Allocator>::data() {
   return array;
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::iterator Array<T, S>::begin() {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::iterator Array<T, S, Allocator>::begin() {
   return array[0];
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::iterator Array<T, S>::end() {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::iterator Array<T, S, Allocator>::end() {
   return array + S;
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::const_reference Array<T, S>::front() const {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::const_reference
+Array<T, S, Allocator>::front() const {
   return array[0];
 }
 
-template <typename T, size_t S>
-typename Array<T, S>::const_reference Array<T, S>::back() const {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::const_reference
+Array<T, S, Allocator>::back() const {
   return array[S - 1];
 }
 
-template <typename T, size_t S>
-bool Array<T, S>::empty() {
+template <typename T, size_t S, typename Allocator>
+bool Array<T, S, Allocator>::empty() {
   bool flag = true;
   if (S == 0) {
     return flag;
@@ -115,27 +149,48 @@ bool Array<T, S>::empty() {
     return flag = false;
 }
 
-template <typename T, size_t S>
-void Array<T, S>::swap(Array<T, S> &a) {
+template <typename T, size_t S, typename Allocator>
+void Array<T, S, Allocator>::swap(Array<T, S, Allocator> &a) {
   for (size_type i = 0; i < S; ++i) {
     std::swap(array[i], a.array[i]);
   }
 }
-template <typename T, size_t S>
-typename Array<T, S>::size_type Array<T, S>::max_size() const noexcept {
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::size_type
+Array<T, S, Allocator>::max_size() const noexcept {
   return S;
 }
 
-template <typename T, size_t S>
-void Array<T, S>::fill(const_reference value) {
+template <typename T, size_t S, typename Allocator>
+void Array<T, S, Allocator>::fill(const_reference value) {
   for (size_type i = 0; i < size(); ++i) {
     array[i] = value;
   }
 }
 
-template <typename T, size_t S>
-Array<T, S>::~Array() {
-  delete[] array;
+template <typename T, size_t S, typename Allocator>
+Array<T, S, Allocator>::~Array() {
+  if (array) {
+    std::destroy(array, array + S);
+    DeallocateStorage();
+  }
+}
+
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::allocator_type
+Array<T, S, Allocator>::get_allocator() const {
+  return GetAllocator();
+}
+
+template <typename T, size_t S, typename Allocator>
+typename Array<T, S, Allocator>::value_type *
+Array<T, S, Allocator>::AllocateStorage() {
+  return S == 0 ? nullptr : allocator_traits::allocate(GetAllocator(), S);
+}
+
+template <typename T, size_t S, typename Allocator>
+void Array<T, S, Allocator>::DeallocateStorage() noexcept {
+  allocator_traits::deallocate(GetAllocator(), array, S);
 }
 
 }  // namespace s21
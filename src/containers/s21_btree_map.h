@@ -0,0 +1,805 @@
+#ifndef CPP2_S21_CONTAINERS_1_BTREE_MAP_H
+#define CPP2_S21_CONTAINERS_1_BTREE_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "s21_allocator.h"
+
+namespace s21 {
+
+/* Node of a B-tree holding up to Slots values in a sorted array. Internal
+ * nodes extend it with Slots + 1 children, child i holds the values
+ * between slot i - 1 and slot i. */
+template <typename Value, std::size_t Slots>
+struct BtreeNode {
+  BtreeNode *parent = nullptr;
+  std::size_t position = 0;  // index in parent->children
+  std::size_t count = 0;
+  bool leaf = true;
+  alignas(Value) unsigned char storage[Slots * sizeof(Value)];
+
+  Value *slot(std::size_t i) noexcept {
+    return std::launder(reinterpret_cast<Value *>(storage) + i);
+  }
+  const Value *slot(std::size_t i) const noexcept {
+    return std::launder(reinterpret_cast<const Value *>(storage) + i);
+  }
+};
+
+template <typename Value, std::size_t Slots>
+struct BtreeInternalNode : BtreeNode<Value, Slots> {
+  BtreeNode<Value, Slots> *children[Slots + 1] = {};
+};
+
+/* Position of a value: a node and a slot in it. end() is the slot past the
+ * last value of the root, or a null node for an empty tree */
+template <typename Value, std::size_t Slots, bool Const>
+class BtreeIterator {
+  using node = BtreeNode<Value, Slots>;
+  using internal_node = BtreeInternalNode<Value, Slots>;
+
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = Value;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const Value *, Value *>;
+  using reference = std::conditional_t<Const, const Value &, Value &>;
+
+  node *curr_node = nullptr;
+  std::size_t curr_slot = 0;
+
+  BtreeIterator() = default;
+  BtreeIterator(node *item, std::size_t slot)
+      : curr_node(item), curr_slot(slot) {}
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  BtreeIterator(const BtreeIterator<Value, Slots, OtherConst> &other)
+      : curr_node(other.curr_node), curr_slot(other.curr_slot) {}
+
+  reference operator*() const noexcept { return *curr_node->slot(curr_slot); }
+  pointer operator->() const noexcept { return curr_node->slot(curr_slot); }
+
+  friend bool operator==(const BtreeIterator &a,
+                         const BtreeIterator &b) noexcept {
+    return a.curr_node == b.curr_node && a.curr_slot == b.curr_slot;
+  }
+  friend bool operator!=(const BtreeIterator &a,
+                         const BtreeIterator &b) noexcept {
+    return !(a == b);
+  }
+
+  BtreeIterator &operator++() noexcept {
+    if (!curr_node->leaf) {
+      curr_node = child_of(curr_node, curr_slot + 1);
+      while (!curr_node->leaf) curr_node = child_of(curr_node, 0);
+      curr_slot = 0;
+      return *this;
+    }
+    ++curr_slot;
+    while (curr_slot == curr_node->count && curr_node->parent) {
+      curr_slot = curr_node->position;
+      curr_node = curr_node->parent;
+    }
+    return *this;
+  }
+  BtreeIterator operator++(int) noexcept {
+    BtreeIterator n = *this;
+    ++*this;
+    return n;
+  }
+
+  BtreeIterator &operator--() noexcept {
+    if (!curr_node->leaf) {
+      curr_node = child_of(curr_node, curr_slot);
+      while (!curr_node->leaf) {
+        curr_node = child_of(curr_node, curr_node->count);
+      }
+      curr_slot = curr_node->count - 1;
+      return *this;
+    }
+    while (curr_slot == 0 && curr_node->parent) {
+      curr_slot = curr_node->position;
+      curr_node = curr_node->parent;
+    }
+    --curr_slot;
+    return *this;
+  }
+  BtreeIterator operator--(int) noexcept {
+    BtreeIterator n = *this;
+    --*this;
+    return n;
+  }
+
+ private:
+  static node *child_of(node *item, std::size_t i) noexcept {
+    return static_cast<internal_node *>(item)->children[i];
+  }
+};
+
+/* Ordered map with the interface of s21::map, stored as a B-tree: every
+ * node keeps up to NodeSize values in one sorted array, so a lookup reads
+ * a few contiguous cache lines per level over about log(n) / log(NodeSize)
+ * levels instead of one scattered node per comparison. NodeSize must be
+ * odd; 0 picks as many values as fit in 256 bytes.
+ * Unlike s21::map, values move between nodes: insert and erase invalidate
+ * all iterators and references, arguments of an insertion must not refer
+ * to other elements of the map, and erase needs a copyable Key to find the
+ * element after the erased one. */
+template <typename Key, typename T, std::size_t NodeSize = 0,
+          typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ private:
+  static constexpr size_type kFitSlots = 256 / sizeof(value_type);
+  /* Largest odd count of values that fits in 256 bytes, but at least 5 */
+  static constexpr size_type kAutoSlots =
+      kFitSlots < 5 ? 5 : (kFitSlots - 1) | size_type(1);
+  static constexpr size_type kSlots = NodeSize != 0 ? NodeSize : kAutoSlots;
+  static_assert(kSlots >= 3 && kSlots % 2 == 1,
+                "btree_map needs an odd NodeSize of at least 3");
+  /* Fewest values erase leaves in a node other than the root. Inserts do
+   * not enforce it: a leaf filled at one end is split next to that end, so
+   * the edge leaves of sorted runs may hold only 1 or 2 values */
+  static constexpr size_type kMinSlots = kSlots / 2;
+
+  using node = BtreeNode<value_type, kSlots>;
+  using internal_node = BtreeInternalNode<value_type, kSlots>;
+  using leaf_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<node>;
+  using internal_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<internal_node>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using internal_traits = std::allocator_traits<internal_allocator>;
+
+ public:
+  using iterator = BtreeIterator<value_type, kSlots, false>;
+  using const_iterator = BtreeIterator<value_type, kSlots, true>;
+
+  /* Member functions */
+
+  btree_map() : btree_map(Compare(), Allocator()) {}
+  explicit btree_map(const Allocator &alloc) : btree_map(Compare(), alloc) {}
+  explicit btree_map(const Compare &comp, const Allocator &alloc = Allocator())
+      : holder_(leaf_allocator(alloc)), compare_(comp) {}
+  btree_map(std::initializer_list<value_type> const &items,
+            const Compare &comp = Compare(),
+            const Allocator &alloc = Allocator())
+      : btree_map(comp, alloc) {
+    for (const value_type &value : items) insert(value);
+  }
+
+  btree_map(const btree_map &other)
+      : holder_(leaf_traits::select_on_container_copy_construction(
+            other.holder_.GetAllocator())),
+        compare_(other.compare_) {
+    copy_from(other);
+  }
+
+  btree_map(btree_map &&other) noexcept
+      : holder_(other.holder_.GetAllocator()),
+        root_(other.root_),
+        size_(other.size_),
+        compare_(other.compare_) {
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~btree_map() { clear(); }
+
+  btree_map &operator=(const btree_map &other) {
+    if (this != &other) {
+      clear();
+      holder_.CopyAssignAllocator(other.holder_);
+      compare_ = other.compare_;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  btree_map &operator=(btree_map &&other) noexcept(
+      leaf_traits::propagate_on_container_move_assignment::value ||
+      leaf_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    clear();
+    compare_ = other.compare_;
+    if (leaf_traits::propagate_on_container_move_assignment::value ||
+        holder_.SameAllocator(other.holder_)) {
+      holder_.MoveAssignAllocator(other.holder_);
+      root_ = other.root_;
+      size_ = other.size_;
+      other.root_ = nullptr;
+      other.size_ = 0;
+    } else {
+      for (value_type &value : other) insert(std::move(value));
+      other.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(holder_.GetAllocator());
+  }
+  key_compare key_comp() const { return compare_; }
+
+  /* Element access */
+
+  [[nodiscard]] T &at(const Key &key) {
+    iterator found = find(key);
+    if (found == end()) throw std::out_of_range("There is no such key!");
+    return found->second;
+  }
+  [[nodiscard]] const T &at(const Key &key) const {
+    const_iterator found = find(key);
+    if (found == end()) throw std::out_of_range("There is no such key!");
+    return found->second;
+  }
+
+  T &operator[](const Key &key) { return try_emplace(key).first->second; }
+  T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  /* Iterators */
+
+  iterator begin() noexcept { return iterator(first_node(), 0); }
+  iterator end() noexcept { return iterator(root_, root_ ? root_->count : 0); }
+  const_iterator begin() const noexcept {
+    return const_iterator(first_node(), 0);
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(root_, root_ ? root_->count : 0);
+  }
+
+  /* Capacity */
+
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] size_type size() const noexcept { return size_; }
+  [[nodiscard]] size_type max_size() const noexcept {
+    return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(value_type);
+  }
+
+  /* Modifiers */
+
+  void clear() noexcept {
+    destroy_tree(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return emplace_key(value.first, value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return emplace_key(value.first, std::move(value));
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplace_key(key, std::piecewise_construct,
+                       std::forward_as_tuple(key),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return emplace_key(key, std::piecewise_construct,
+                       std::forward_as_tuple(std::move(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return emplace_key(value.first, std::move(value));
+  }
+
+  iterator erase(const_iterator pos) {
+    const_iterator next = pos;
+    ++next;
+    if (next == end()) {
+      erase_slot(pos.curr_node, pos.curr_slot);
+      return end();
+    }
+    Key next_key = next->first;
+    erase_slot(pos.curr_node, pos.curr_slot);
+    return lower_bound(next_key);
+  }
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  size_type erase(const Key &key) {
+    iterator found = find(key);
+    if (found == end()) return 0;
+    erase_slot(found.curr_node, found.curr_slot);
+    return 1;
+  }
+
+  void swap(btree_map &other) noexcept {
+    holder_.SwapAllocator(other.holder_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(compare_, other.compare_);
+  }
+
+  /* Moves the elements whose keys are missing here out of other */
+  void merge(btree_map &other) {
+    if (this == &other) return;
+    for (iterator it = other.begin(); it != other.end();) {
+      if (try_emplace(it->first, std::move(it->second)).second) {
+        it = other.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /* Lookup */
+
+  iterator find(const Key &key) {
+    iterator found = lower_bound(key);
+    if (found == end() || compare_(key, found->first)) return end();
+    return found;
+  }
+  const_iterator find(const Key &key) const {
+    return const_cast<btree_map *>(this)->find(key);
+  }
+
+  [[nodiscard]] bool contains(const Key &key) const {
+    return find(key) != end();
+  }
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  /* First element whose key is not less than key */
+  iterator lower_bound(const Key &key) {
+    iterator result = end();
+    node *current = root_;
+    while (current) {
+      size_type i = lower_slot(current, key);
+      if (i < current->count) {
+        result = iterator(current, i);
+        if (!compare_(key, current->slot(i)->first)) return result;
+      }
+      current = current->leaf ? nullptr : child(current, i);
+    }
+    return result;
+  }
+  const_iterator lower_bound(const Key &key) const {
+    return const_cast<btree_map *>(this)->lower_bound(key);
+  }
+
+  /* First element whose key is greater than key */
+  iterator upper_bound(const Key &key) {
+    iterator result = end();
+    node *current = root_;
+    while (current) {
+      size_type i = upper_slot(current, key);
+      if (i < current->count) result = iterator(current, i);
+      current = current->leaf ? nullptr : child(current, i);
+    }
+    return result;
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return const_cast<btree_map *>(this)->upper_bound(key);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    iterator first = lower_bound(key);
+    if (first == end() || compare_(key, first->first)) {
+      return std::make_pair(first, first);
+    }
+    iterator last = first;
+    return std::make_pair(first, ++last);
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    return const_cast<btree_map *>(this)->equal_range(key);
+  }
+
+  /* Number of levels, 0 for an empty map */
+  size_type height() const noexcept {
+    size_type levels = 0;
+    for (node *current = root_; current;
+         current = current->leaf ? nullptr : child(current, 0)) {
+      ++levels;
+    }
+    return levels;
+  }
+
+  static constexpr size_type node_size() noexcept { return kSlots; }
+
+ private:
+  static node *child(node *item, size_type i) noexcept {
+    return static_cast<internal_node *>(item)->children[i];
+  }
+  static void set_child(node *item, size_type i, node *value) noexcept {
+    static_cast<internal_node *>(item)->children[i] = value;
+    if (value) {
+      value->parent = item;
+      value->position = i;
+    }
+  }
+
+  /* First slot whose key is not less than key, binary search */
+  size_type lower_slot(const node *item, const Key &key) const {
+    size_type low = 0;
+    size_type high = item->count;
+    while (low < high) {
+      size_type middle = (low + high) / 2;
+      if (compare_(item->slot(middle)->first, key)) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  /* First slot whose key is greater than key */
+  size_type upper_slot(const node *item, const Key &key) const {
+    size_type low = 0;
+    size_type high = item->count;
+    while (low < high) {
+      size_type middle = (low + high) / 2;
+      if (compare_(key, item->slot(middle)->first)) {
+        high = middle;
+      } else {
+        low = middle + 1;
+      }
+    }
+    return low;
+  }
+
+  node *first_node() const noexcept {
+    node *current = root_;
+    while (current && !current->leaf) current = child(current, 0);
+    return current ? current : root_;
+  }
+
+  node *create_leaf() {
+    leaf_allocator &alloc = holder_.GetAllocator();
+    node *item = leaf_traits::allocate(alloc, 1);
+    return ::new (static_cast<void *>(item)) node;
+  }
+
+  node *create_internal() {
+    internal_allocator alloc(holder_.GetAllocator());
+    internal_node *item = internal_traits::allocate(alloc, 1);
+    ::new (static_cast<void *>(item)) internal_node;
+    item->leaf = false;
+    return item;
+  }
+
+  /* Frees the node itself, its values must be gone */
+  void release_node(node *item) noexcept {
+    if (item->leaf) {
+      item->~node();
+      leaf_traits::deallocate(holder_.GetAllocator(), item, 1);
+    } else {
+      internal_node *internal = static_cast<internal_node *>(item);
+      internal->~internal_node();
+      internal_allocator alloc(holder_.GetAllocator());
+      internal_traits::deallocate(alloc, internal, 1);
+    }
+  }
+
+  void destroy_values(node *item) noexcept {
+    for (size_type i = 0; i < item->count; ++i) item->slot(i)->~value_type();
+    item->count = 0;
+  }
+
+  /* Post-order walk along parent links, no recursion. Missing children
+   * (left by a copy that failed) end the children of a node */
+  void destroy_tree(node *item) noexcept {
+    if (!item) return;
+    while (!item->leaf && child(item, 0)) item = child(item, 0);
+    while (true) {
+      node *parent = item->parent;
+      size_type next = item->position + 1;
+      destroy_values(item);
+      release_node(item);
+      if (!parent) break;
+      if (next <= parent->count && child(parent, next)) {
+        item = child(parent, next);
+        while (!item->leaf && child(item, 0)) item = child(item, 0);
+      } else {
+        item = parent;
+      }
+    }
+  }
+
+  /* Moves the value in slot from of source into the empty slot to of
+   * target */
+  static void move_slot(node *target, size_type to, node *source,
+                        size_type from) {
+    ::new (static_cast<void *>(target->slot(to)))
+        value_type(std::move(*source->slot(from)));
+    source->slot(from)->~value_type();
+  }
+
+  /* Opens an empty slot at i by moving the values from i on one step
+   * right; internal nodes move their children with them */
+  static void open_slot(node *item, size_type i) {
+    for (size_type j = item->count; j > i; --j) move_slot(item, j, item, j - 1);
+    if (!item->leaf) {
+      for (size_type j = item->count + 1; j > i + 1; --j) {
+        set_child(item, j, child(item, j - 1));
+      }
+    }
+  }
+
+  /* Splits the full child i of parent: it keeps its first keep values,
+   * the next one moves up into parent, which must have room, and the rest
+   * move into the empty node right */
+  static void split_child(node *parent, size_type i, node *right,
+                          size_type keep) {
+    node *full = child(parent, i);
+    size_type moved = kSlots - keep - 1;
+    for (size_type j = 0; j < moved; ++j) {
+      move_slot(right, j, full, keep + 1 + j);
+    }
+    if (!full->leaf) {
+      for (size_type j = 0; j <= moved; ++j) {
+        set_child(right, j, child(full, keep + 1 + j));
+      }
+    }
+    right->count = moved;
+    open_slot(parent, i);
+    move_slot(parent, i, full, keep);
+    full->count = keep;
+    set_child(parent, i + 1, right);
+    ++parent->count;
+  }
+
+  /* Splits the full node item in two, splitting full ancestors first and
+   * growing a new root when the split reaches the top. Recursion depth is
+   * bounded by the height of the tree */
+  void split_node(node *item, size_type keep = kMinSlots) {
+    if (item->parent && item->parent->count == kSlots) {
+      split_node(item->parent);
+    }
+    node *right = item->leaf ? create_leaf() : create_internal();
+    if (!item->parent) {
+      node *new_root;
+      try {
+        new_root = create_internal();
+      } catch (...) {
+        release_node(right);
+        throw;
+      }
+      set_child(new_root, 0, item);
+      new_root->parent = nullptr;
+      root_ = new_root;
+    }
+    split_child(item->parent, item->position, right, keep);
+  }
+
+  /* Inserts a value built from args unless key is present. The leaf is
+   * found before anything moves, so key may refer to an element of the
+   * map; only a full leaf is split, bottom-up. A leaf filled at one end
+   * is split next to that end, so ascending or descending runs leave
+   * nearly full leaves behind instead of half empty ones */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_key(const Key &key, Args &&...args) {
+    if (!root_) root_ = create_leaf();
+    node *current = root_;
+    size_type i = 0;
+    while (true) {
+      i = lower_slot(current, key);
+      if (i < current->count && !compare_(key, current->slot(i)->first)) {
+        return std::make_pair(iterator(current, i), false);
+      }
+      if (current->leaf) break;
+      current = child(current, i);
+    }
+    if (current->count == kSlots) {
+      size_type keep = kMinSlots;
+      if (i == 0) keep = 1;
+      if (i == kSlots) keep = kSlots - 2;
+      split_node(current, keep);
+      if (i > keep) {
+        current = child(current->parent, current->position + 1);
+        i -= keep + 1;
+      }
+    }
+    open_slot(current, i);
+    ++current->count;
+    try {
+      ::new (static_cast<void *>(current->slot(i)))
+          value_type(std::forward<Args>(args)...);
+    } catch (...) {
+      close_slot_without_value(current, i);
+      throw;
+    }
+    ++size_;
+    return std::make_pair(iterator(current, i), true);
+  }
+
+  /* Closes the slot i whose value is already gone */
+  static void close_slot_without_value(node *item, size_type i) noexcept {
+    for (size_type j = i; j + 1 < item->count; ++j) {
+      move_slot(item, j, item, j + 1);
+    }
+    --item->count;
+  }
+
+  /* Removes the value in slot i of item and restores the minimum fill of
+   * every node from the leaf up */
+  void erase_slot(node *item, size_type i) {
+    item->slot(i)->~value_type();
+    if (!item->leaf) {
+      // replace the value by its in-order predecessor taken from a leaf
+      node *leaf = child(item, i);
+      while (!leaf->leaf) leaf = child(leaf, leaf->count);
+      move_slot(item, i, leaf, leaf->count - 1);
+      --leaf->count;
+      item = leaf;
+    } else {
+      close_slot_without_value(item, i);
+    }
+    --size_;
+    rebalance(item);
+  }
+
+  void rebalance(node *item) {
+    while (item != root_ && item->count < kMinSlots) {
+      node *parent = item->parent;
+      size_type pos = item->position;
+      if (pos > 0 && child(parent, pos - 1)->count > kMinSlots) {
+        rotate_right(parent, pos - 1);
+        return;
+      }
+      if (pos < parent->count && child(parent, pos + 1)->count > kMinSlots) {
+        rotate_left(parent, pos);
+        return;
+      }
+      merge_children(parent, pos > 0 ? pos - 1 : pos);
+      item = parent;
+    }
+    if (root_->count == 0) {
+      node *old_root = root_;
+      root_ = old_root->leaf ? nullptr : child(old_root, 0);
+      if (root_) root_->parent = nullptr;
+      release_node(old_root);
+    }
+  }
+
+  /* Moves the last value of child i through the separator into child
+   * i + 1 */
+  static void rotate_right(node *parent, size_type i) {
+    node *left = child(parent, i);
+    node *right = child(parent, i + 1);
+    open_slot(right, 0);
+    move_slot(right, 0, parent, i);
+    move_slot(parent, i, left, left->count - 1);
+    if (!right->leaf) {
+      // open_slot kept child 0 in place, the moved value needs it at 1
+      set_child(right, 1, child(right, 0));
+      set_child(right, 0, child(left, left->count));
+    }
+    --left->count;
+    ++right->count;
+  }
+
+  /* Moves the first value of child i + 1 through the separator into
+   * child i */
+  static void rotate_left(node *parent, size_type i) {
+    node *left = child(parent, i);
+    node *right = child(parent, i + 1);
+    move_slot(left, left->count, parent, i);
+    move_slot(parent, i, right, 0);
+    if (!left->leaf) set_child(left, left->count + 1, child(right, 0));
+    ++left->count;
+    for (size_type j = 0; j + 1 < right->count; ++j) {
+      move_slot(right, j, right, j + 1);
+    }
+    if (!right->leaf) {
+      for (size_type j = 0; j < right->count; ++j) {
+        set_child(right, j, child(right, j + 1));
+      }
+    }
+    --right->count;
+  }
+
+  /* Joins child i, the separator i and child i + 1 into child i */
+  void merge_children(node *parent, size_type i) {
+    node *left = child(parent, i);
+    node *right = child(parent, i + 1);
+    size_type base = left->count;
+    move_slot(left, base, parent, i);
+    for (size_type j = 0; j < right->count; ++j) {
+      move_slot(left, base + 1 + j, right, j);
+    }
+    if (!left->leaf) {
+      for (size_type j = 0; j <= right->count; ++j) {
+        set_child(left, base + 1 + j, child(right, j));
+      }
+    }
+    left->count = base + 1 + right->count;
+    right->count = 0;
+    release_node(right);
+    close_slot_without_value(parent, i);
+    for (size_type j = i + 1; j <= parent->count; ++j) {
+      set_child(parent, j, child(parent, j + 1));
+    }
+  }
+
+  /* Clones the nodes of other level by level along parent links */
+  void copy_from(const btree_map &other) {
+    if (!other.root_) return;
+    const node *source = other.root_;
+    try {
+      root_ = clone_node(source);
+      node *target = root_;
+      size_type next = 0;
+      while (true) {
+        if (!source->leaf && next <= source->count) {
+          node *copy = clone_node(child(const_cast<node *>(source), next));
+          set_child(target, next, copy);
+          source = child(const_cast<node *>(source), next);
+          target = copy;
+          next = 0;
+        } else if (source != other.root_) {
+          next = source->position + 1;
+          source = source->parent;
+          target = target->parent;
+        } else {
+          break;
+        }
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+    size_ = other.size_;
+  }
+
+  node *clone_node(const node *source) {
+    node *copy = source->leaf ? create_leaf() : create_internal();
+    try {
+      for (; copy->count < source->count; ++copy->count) {
+        ::new (static_cast<void *>(copy->slot(copy->count)))
+            value_type(*source->slot(copy->count));
+      }
+    } catch (...) {
+      destroy_values(copy);
+      release_node(copy);
+      throw;
+    }
+    return copy;
+  }
+
+  AllocatorHolder<leaf_allocator> holder_;
+  node *root_ = nullptr;
+  size_type size_ = 0;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_BTREE_MAP_H
@@ -0,0 +1,527 @@
+#ifndef CPP2_S21_CONTAINERS_1_FLAT_MAP_H
+#define CPP2_S21_CONTAINERS_1_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flat/flat_search.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+/* Walks the parallel key and value arrays of a flat_map together.
+ * Dereferencing yields a pair of references, so it->first and it->second
+ * work as for s21::map */
+template <typename Key, typename T, bool Const>
+class FlatMapIterator {
+  using mapped_ref = std::conditional_t<Const, const T &, T &>;
+  using mapped_ptr = std::conditional_t<Const, const T *, T *>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::pair<Key, T>;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::pair<const Key &, mapped_ref>;
+
+  struct pointer {
+    reference ref;
+    reference *operator->() noexcept { return &ref; }
+  };
+
+  FlatMapIterator() = default;
+  FlatMapIterator(const Key *key, mapped_ptr mapped)
+      : key_(key), mapped_(mapped) {}
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  FlatMapIterator(const FlatMapIterator<Key, T, OtherConst> &other)
+      : key_(other.key_), mapped_(other.mapped_) {}
+
+  reference operator*() const noexcept { return reference(*key_, *mapped_); }
+  pointer operator->() const noexcept { return pointer{**this}; }
+  reference operator[](difference_type n) const noexcept {
+    return *(*this + n);
+  }
+
+  FlatMapIterator &operator++() noexcept { return *this += 1; }
+  FlatMapIterator operator++(int) noexcept {
+    FlatMapIterator n = *this;
+    ++*this;
+    return n;
+  }
+  FlatMapIterator &operator--() noexcept { return *this -= 1; }
+  FlatMapIterator operator--(int) noexcept {
+    FlatMapIterator n = *this;
+    --*this;
+    return n;
+  }
+  FlatMapIterator &operator+=(difference_type n) noexcept {
+    key_ += n;
+    mapped_ += n;
+    return *this;
+  }
+  FlatMapIterator &operator-=(difference_type n) noexcept {
+    return *this += -n;
+  }
+
+  friend FlatMapIterator operator+(FlatMapIterator it,
+                                   difference_type n) noexcept {
+    return it += n;
+  }
+  friend FlatMapIterator operator+(difference_type n,
+                                   FlatMapIterator it) noexcept {
+    return it += n;
+  }
+  friend FlatMapIterator operator-(FlatMapIterator it,
+                                   difference_type n) noexcept {
+    return it -= n;
+  }
+  friend difference_type operator-(const FlatMapIterator &a,
+                                   const FlatMapIterator &b) noexcept {
+    return a.key_ - b.key_;
+  }
+
+  friend bool operator==(const FlatMapIterator &a,
+                         const FlatMapIterator &b) noexcept {
+    return a.key_ == b.key_;
+  }
+  friend bool operator!=(const FlatMapIterator &a,
+                         const FlatMapIterator &b) noexcept {
+    return a.key_ != b.key_;
+  }
+  friend bool operator<(const FlatMapIterator &a,
+                        const FlatMapIterator &b) noexcept {
+    return a.key_ < b.key_;
+  }
+  friend bool operator>(const FlatMapIterator &a,
+                        const FlatMapIterator &b) noexcept {
+    return b < a;
+  }
+  friend bool operator<=(const FlatMapIterator &a,
+                         const FlatMapIterator &b) noexcept {
+    return !(b < a);
+  }
+  friend bool operator>=(const FlatMapIterator &a,
+                         const FlatMapIterator &b) noexcept {
+    return !(a < b);
+  }
+
+ private:
+  template <typename, typename, bool>
+  friend class FlatMapIterator;
+
+  const Key *key_ = nullptr;
+  mapped_ptr mapped_ = nullptr;
+};
+
+/* Map with the interface of s21::map kept as two parallel s21::Vector
+ * arrays: the sorted keys and their values. A lookup binary-searches the
+ * dense key array alone and touches a value only once the key is found.
+ * It suits tables built once and read many times: build it from a whole
+ * range (sorted and deduplicated once) rather than key by key, since a
+ * single insert or erase shifts both tails in O(n) and invalidates
+ * iterators. */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<Key, T>>>
+class flat_map {
+  using traits = std::allocator_traits<Allocator>;
+
+ public:
+  using key_container_type =
+      Vector<Key, growth::Double, typename traits::template rebind_alloc<Key>>;
+  using mapped_container_type =
+      Vector<T, growth::Double, typename traits::template rebind_alloc<T>>;
+
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using reference = std::pair<const Key &, T &>;
+  using const_reference = std::pair<const Key &, const T &>;
+  using iterator = FlatMapIterator<Key, T, false>;
+  using const_iterator = FlatMapIterator<Key, T, true>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  /* Member functions */
+
+  flat_map() : flat_map(Compare(), Allocator()) {}
+  explicit flat_map(const Allocator &alloc) : flat_map(Compare(), alloc) {}
+  explicit flat_map(const Compare &comp, const Allocator &alloc = Allocator())
+      : keys_(typename key_container_type::allocator_type(alloc)),
+        values_(typename mapped_container_type::allocator_type(alloc)),
+        compare_(comp) {}
+  flat_map(std::initializer_list<value_type> const &items,
+           const Compare &comp = Compare(),
+           const Allocator &alloc = Allocator())
+      : flat_map(items.begin(), items.end(), comp, alloc) {}
+  flat_map(std::initializer_list<value_type> const &items,
+           const Allocator &alloc)
+      : flat_map(items, Compare(), alloc) {}
+
+  /* Sorts the range once and drops repeated keys, the first one wins */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  flat_map(InputIt first, InputIt last, const Compare &comp = Compare(),
+           const Allocator &alloc = Allocator())
+      : flat_map(comp, alloc) {
+    insert(first, last);
+  }
+
+  /* Adopts a range already sorted by Compare in O(n), repeated keys are
+   * skipped */
+  template <typename InputIt>
+  static flat_map from_sorted(InputIt first, InputIt last,
+                              const Compare &comp = Compare(),
+                              const Allocator &alloc = Allocator()) {
+    flat_map result(comp, alloc);
+    for (; first != last; ++first) {
+      const auto &item = *first;
+      if (result.empty() || comp(result.keys_.back(), item.first)) {
+        result.keys_.push_back(item.first);
+        result.values_.push_back(item.second);
+      }
+    }
+    return result;
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(keys_.get_allocator());
+  }
+  key_compare key_comp() const { return compare_; }
+
+  /* The sorted keys and the values in the same order */
+  const key_container_type &keys() const noexcept { return keys_; }
+  const mapped_container_type &values() const noexcept { return values_; }
+
+  /* Element access */
+
+  [[nodiscard]] T &at(const Key &key) {
+    size_type index = find_index(key);
+    if (index == size()) throw std::out_of_range("There is no such key!");
+    return values_[index];
+  }
+  [[nodiscard]] const T &at(const Key &key) const {
+    size_type index = find_index(key);
+    if (index == size()) throw std::out_of_range("There is no such key!");
+    return values_[index];
+  }
+
+  T &operator[](const Key &key) { return try_emplace(key).first->second; }
+  T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  /* Iterators */
+
+  iterator begin() noexcept { return make_iterator(0); }
+  iterator end() noexcept { return make_iterator(size()); }
+  const_iterator begin() const noexcept { return make_iterator(0); }
+  const_iterator end() const noexcept { return make_iterator(size()); }
+
+  /* Capacity */
+
+  [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+  [[nodiscard]] size_type size() const noexcept { return keys_.size(); }
+  [[nodiscard]] size_type max_size() const noexcept {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+
+  /* Modifiers */
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  /* Sorts the new items and merges them with the stored ones in one pass:
+   * O(n + m log m) instead of m shifts of the tails. Keys already present
+   * keep their values */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  void insert(InputIt first, InputIt last) {
+    Vector<value_type, growth::Double,
+           typename traits::template rebind_alloc<value_type>>
+        items(first, last, get_allocator());
+    std::stable_sort(items.begin(), items.end(),
+                     [this](const value_type &a, const value_type &b) {
+                       return compare_(a.first, b.first);
+                     });
+    key_container_type keys(keys_.get_allocator());
+    mapped_container_type values(values_.get_allocator());
+    keys.reserve(keys_.size() + items.size());
+    values.reserve(keys_.size() + items.size());
+    size_type i = 0;
+    for (value_type &item : items) {
+      for (; i < size() && compare_(keys_[i], item.first); ++i) {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i]));
+      }
+      bool stored = i < size() && !compare_(item.first, keys_[i]);
+      bool repeated = !keys.empty() && !compare_(keys.back(), item.first);
+      if (!stored && !repeated) {
+        keys.push_back(std::move(item.first));
+        values.push_back(std::move(item.second));
+      }
+    }
+    for (; i < size(); ++i) {
+      keys.push_back(std::move(keys_[i]));
+      values.push_back(std::move(values_[i]));
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+  }
+
+  /* The bool is true if the key was inserted and false if obj was assigned
+   * to an existing element */
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  /* Inserts a value built from args unless key is present; in that case
+   * args are left untouched */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplace_key(key, key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return emplace_key(key, std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type value(std::forward<Args>(args)...);
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  iterator erase(const_iterator pos) {
+    size_type index = static_cast<size_type>(pos - begin());
+    keys_.erase(keys_.begin() + index);
+    values_.erase(values_.begin() + index);
+    return make_iterator(index);
+  }
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  size_type erase(const Key &key) {
+    size_type index = find_index(key);
+    if (index == size()) return 0;
+    erase(begin() + index);
+    return 1;
+  }
+
+  void swap(flat_map &other) {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+    std::swap(compare_, other.compare_);
+  }
+
+  /* Moves the elements of other whose keys are missing here in one linear
+   * pass, the duplicates stay in other */
+  void merge(flat_map &other) {
+    if (this == &other) return;
+    key_container_type keys(keys_.get_allocator());
+    mapped_container_type values(values_.get_allocator());
+    keys.reserve(size() + other.size());
+    values.reserve(size() + other.size());
+    size_type i = 0, j = 0, kept = 0;
+    while (i < size() || j < other.size()) {
+      if (j == other.size() ||
+          (i < size() && compare_(keys_[i], other.keys_[j]))) {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i++]));
+      } else if (i == size() || compare_(other.keys_[j], keys_[i])) {
+        keys.push_back(std::move(other.keys_[j]));
+        values.push_back(std::move(other.values_[j++]));
+      } else {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i++]));
+        if (kept != j) {
+          other.keys_[kept] = std::move(other.keys_[j]);
+          other.values_[kept] = std::move(other.values_[j]);
+        }
+        ++kept;
+        ++j;
+      }
+    }
+    other.keys_.erase(other.keys_.begin() + kept, other.keys_.end());
+    other.values_.erase(other.values_.begin() + kept, other.values_.end());
+    keys_.swap(keys);
+    values_.swap(values);
+  }
+
+  /* Lookup */
+
+  iterator find(const Key &key) { return make_iterator(find_index(key)); }
+  const_iterator find(const Key &key) const {
+    return make_iterator(find_index(key));
+  }
+
+  [[nodiscard]] bool contains(const Key &key) const {
+    return find_index(key) != size();
+  }
+  size_type count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  iterator lower_bound(const Key &key) {
+    return make_iterator(lower_index(key));
+  }
+  const_iterator lower_bound(const Key &key) const {
+    return make_iterator(lower_index(key));
+  }
+  iterator upper_bound(const Key &key) {
+    return make_iterator(upper_index(key));
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return make_iterator(upper_index(key));
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    size_type index = find_index(key);
+    if (index == size()) {
+      return std::make_pair(lower_bound(key), lower_bound(key));
+    }
+    return std::make_pair(make_iterator(index), make_iterator(index + 1));
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    return const_cast<flat_map *>(this)->equal_range(key);
+  }
+
+  /* Heterogeneous lookup, available when Compare is transparent (for
+   * example std::less<>): a std::string key can be found by a
+   * std::string_view without building a temporary key */
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return make_iterator(find_index(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return make_iterator(find_index(key));
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  [[nodiscard]] bool contains(const K &key) const {
+    return find_index(key) != size();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return make_iterator(lower_index(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K &key) const {
+    return make_iterator(lower_index(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return make_iterator(upper_index(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K &key) const {
+    return make_iterator(upper_index(key));
+  }
+
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    size_type index = find_index(key);
+    if (index == size()) {
+      return std::make_pair(lower_bound(key), lower_bound(key));
+    }
+    return std::make_pair(make_iterator(index), make_iterator(index + 1));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return const_cast<flat_map *>(this)->equal_range(key);
+  }
+
+ private:
+  iterator make_iterator(size_type index) noexcept {
+    return iterator(keys_.data() + index, values_.data() + index);
+  }
+  const_iterator make_iterator(size_type index) const noexcept {
+    return const_iterator(keys_.data() + index, values_.data() + index);
+  }
+
+  template <typename K>
+  size_type lower_index(const K &key) const {
+    return flat::lower_index(keys_.data(), size(), key, compare_);
+  }
+  template <typename K>
+  size_type upper_index(const K &key) const {
+    return flat::upper_index(keys_.data(), size(), key, compare_);
+  }
+
+  /* Index of key, or size() if it is missing */
+  template <typename K>
+  size_type find_index(const K &key) const {
+    size_type index = lower_index(key);
+    if (index == size() || compare_(key, keys_[index])) return size();
+    return index;
+  }
+
+  /* Inserts stored_key and a value built from args at the slot of key
+   * unless key is present. The value is built before either array moves,
+   * and the key is taken out again if placing the value throws */
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_key(const Key &key, K &&stored_key,
+                                        Args &&...args) {
+    size_type index = lower_index(key);
+    if (index < size() && !compare_(key, keys_[index])) {
+      return std::make_pair(make_iterator(index), false);
+    }
+    T value(std::forward<Args>(args)...);
+    keys_.emplace(keys_.begin() + index, std::forward<K>(stored_key));
+    try {
+      values_.emplace(values_.begin() + index, std::move(value));
+    } catch (...) {
+      keys_.erase(keys_.begin() + index);
+      throw;
+    }
+    return std::make_pair(make_iterator(index), true);
+  }
+
+  key_container_type keys_;
+  mapped_container_type values_;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_FLAT_MAP_H
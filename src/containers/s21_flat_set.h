@@ -0,0 +1,259 @@
+#ifndef CPP2_S21_CONTAINERS_1_FLAT_SET_H
+#define CPP2_S21_CONTAINERS_1_FLAT_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "flat/flat_search.h"
+#include "s21_vector.h"
+
+namespace s21 {
+
+/* Set with the interface of s21::set kept as one sorted s21::Vector of
+ * keys. Lookups are binary searches over contiguous memory, so it suits
+ * tables built once and read many times: build it from a whole range
+ * (sorted and deduplicated once) rather than key by key, since a single
+ * insert or erase shifts the tail in O(n) and invalidates iterators. */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_set {
+ public:
+  using container_type = Vector<Key, growth::Double, Allocator>;
+
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  flat_set() = default;
+  explicit flat_set(const allocator_type& alloc) : keys_(alloc) {}
+  explicit flat_set(const Compare& comp,
+                    const allocator_type& alloc = allocator_type())
+      : keys_(alloc), compare_(comp) {}
+  flat_set(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const allocator_type& alloc = allocator_type())
+      : flat_set(items.begin(), items.end(), comp, alloc) {}
+  flat_set(std::initializer_list<value_type> const& items,
+           const allocator_type& alloc)
+      : flat_set(items, Compare(), alloc) {}
+
+  /* Sorts the range once and drops repeated keys, the first one wins */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  flat_set(InputIt first, InputIt last, const Compare& comp = Compare(),
+           const allocator_type& alloc = allocator_type())
+      : keys_(alloc), compare_(comp) {
+    keys_.assign(first, last);
+    std::stable_sort(keys_.begin(), keys_.end(), compare_);
+    drop_duplicates();
+  }
+
+  /* Adopts a range already sorted by Compare in O(n), repeated keys are
+   * skipped */
+  template <typename InputIt>
+  static flat_set from_sorted(InputIt first, InputIt last,
+                              const Compare& comp = Compare(),
+                              const allocator_type& alloc = allocator_type()) {
+    flat_set result(comp, alloc);
+    result.keys_.assign(first, last);
+    result.drop_duplicates();
+    return result;
+  }
+
+  // Iterators
+  iterator begin() const { return keys_.begin(); }
+  iterator end() const { return keys_.end(); }
+
+  // Capacity
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  size_type max_size() const { return keys_.max_size(); }
+  void reserve(size_type count) { keys_.reserve(count); }
+
+  /* The sorted keys, e.g. to hand the table to code expecting an array */
+  const container_type& keys() const noexcept { return keys_; }
+
+  // Modifiers
+  void clear() { keys_.clear(); }
+  allocator_type get_allocator() const { return keys_.get_allocator(); }
+  key_compare key_comp() const { return compare_; }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace(std::move(value));
+  }
+
+  /* Appends the range, sorts only the new keys and merges them in:
+   * O(n + m log m) instead of m shifts of the tail. Keys already present
+   * are kept */
+  template <typename InputIt,
+            typename = typename std::iterator_traits<InputIt>::value_type>
+  void insert(InputIt first, InputIt last) {
+    size_type old_size = keys_.size();
+    keys_.insert(keys_.end(), first, last);
+    std::stable_sort(keys_.begin() + old_size, keys_.end(), compare_);
+    std::inplace_merge(keys_.begin(), keys_.begin() + old_size, keys_.end(),
+                       compare_);
+    drop_duplicates();
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    value_type value(std::forward<Args>(args)...);
+    size_type index = lower_index(value);
+    if (index < keys_.size() && !compare_(value, keys_[index])) {
+      return std::make_pair(begin() + index, false);
+    }
+    return std::make_pair(keys_.emplace(begin() + index, std::move(value)),
+                          true);
+  }
+
+  iterator erase(iterator pos) {
+    if (pos == end()) {
+      throw std::out_of_range("flat_set::erase()");
+    }
+    return keys_.erase(pos);
+  }
+
+  size_type erase(const Key& key) {
+    size_type index = find_index(key);
+    if (index == size()) return 0;
+    keys_.erase(begin() + index);
+    return 1;
+  }
+
+  void swap(flat_set& other) {
+    keys_.swap(other.keys_);
+    std::swap(compare_, other.compare_);
+  }
+
+  /* Moves the keys of other that are missing here in one linear pass, the
+   * duplicates stay in other */
+  void merge(flat_set& other) {
+    if (this == &other) return;
+    container_type merged(keys_.get_allocator());
+    merged.reserve(keys_.size() + other.keys_.size());
+    size_type i = 0, j = 0, kept = 0;
+    while (i < keys_.size() || j < other.keys_.size()) {
+      if (j == other.keys_.size() ||
+          (i < keys_.size() && compare_(keys_[i], other.keys_[j]))) {
+        merged.push_back(std::move(keys_[i++]));
+      } else if (i == keys_.size() || compare_(other.keys_[j], keys_[i])) {
+        merged.push_back(std::move(other.keys_[j++]));
+      } else {
+        merged.push_back(std::move(keys_[i++]));
+        if (kept != j) other.keys_[kept] = std::move(other.keys_[j]);
+        ++kept;
+        ++j;
+      }
+    }
+    other.keys_.erase(other.keys_.begin() + kept, other.keys_.end());
+    keys_.swap(merged);
+  }
+
+  // Lookup
+  iterator find(const Key& key) const { return begin() + find_index(key); }
+  bool contains(const Key& key) const { return find_index(key) != size(); }
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+  std::pair<iterator, iterator> equal_range(const Key& key) const {
+    return range_of(key);
+  }
+  iterator lower_bound(const Key& key) const {
+    return begin() + lower_index(key);
+  }
+  iterator upper_bound(const Key& key) const {
+    return begin() + upper_index(key);
+  }
+
+  /* Heterogeneous lookup, available when Compare is transparent (for
+   * example std::less<>): a std::string key can be found by a
+   * std::string_view without building a temporary key */
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key) const {
+    return begin() + find_index(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const {
+    return find_index(key) != size();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    return range_of(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K& key) const {
+    return begin() + lower_index(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K& key) const {
+    return begin() + upper_index(key);
+  }
+
+ private:
+  /* The helpers below take K as given, so a key is never converted per
+   * probe of the search */
+  template <typename K>
+  size_type lower_index(const K& key) const {
+    return flat::lower_index(keys_.data(), keys_.size(), key, compare_);
+  }
+  template <typename K>
+  size_type upper_index(const K& key) const {
+    return flat::upper_index(keys_.data(), keys_.size(), key, compare_);
+  }
+
+  /* Index of key, or size() if it is missing */
+  template <typename K>
+  size_type find_index(const K& key) const {
+    size_type index = lower_index(key);
+    if (index == size() || compare_(key, keys_[index])) return size();
+    return index;
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> range_of(const K& key) const {
+    size_type index = lower_index(key);
+    if (index == size() || compare_(key, keys_[index])) {
+      return std::make_pair(begin() + index, begin() + index);
+    }
+    return std::make_pair(begin() + index, begin() + index + 1);
+  }
+
+  /* Removes the keys equal to their sorted predecessor */
+  void drop_duplicates() {
+    auto last = std::unique(keys_.begin(), keys_.end(),
+                            [this](const Key& a, const Key& b) {
+                              return !compare_(a, b);
+                            });
+    keys_.erase(last, keys_.end());
+  }
+
+  container_type keys_;
+  Compare compare_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_FLAT_SET_H
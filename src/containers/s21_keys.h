@@ -0,0 +1,28 @@
+#ifndef CPP2_S21_CONTAINERS_1_S21_KEYS_H
+#define CPP2_S21_CONTAINERS_1_S21_KEYS_H
+
+namespace s21 {
+
+/* Key extractors: how a container gets the key out of a stored value */
+namespace keys {
+/* The value is the key (set, multiset) */
+struct Identity {
+  template <typename T>
+  const T &operator()(const T &value) const noexcept {
+    return value;
+  }
+};
+
+/* The key is the first member of a pair (map, multimap) */
+struct First {
+  template <typename Pair>
+  const typename Pair::first_type &operator()(
+      const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+}  // namespace keys
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_KEYS_H
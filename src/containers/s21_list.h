@@ -1,54 +1,98 @@
 #ifndef CPP2_S21_CONTAINERS_1_S21_LIST_H
 #define CPP2_S21_CONTAINERS_1_S21_LIST_H
+#include <functional>
 #include <limits>
+#include <memory>
+#include <utility>
 
 #include "initializer_list"
+#include "s21_allocator.h"
 #include "stdexcept"
 
 namespace s21 {
+
+/* Links of a s21::List node. The ChainNode of a list is a bare ListNodeBase
+ * embedded in the list object, so it holds no value. */
+struct ListNodeBase {
+  ListNodeBase *next;
+  ListNodeBase *prev;
+};
+
 template <typename T>
-class List {
+struct ListNode : ListNodeBase {
+  template <typename... Args>
+  explicit ListNode(Args &&...args)
+      : ListNodeBase{nullptr, nullptr}, value(std::forward<Args>(args)...) {}
+
+  T value;
+};
+
+/* Nodes are allocated with Allocator rebound to ListNode<T> */
+template <typename T, typename Allocator = std::allocator<T>>
+class List
+    : private AllocatorHolder<typename std::allocator_traits<
+          Allocator>::template rebind_alloc<ListNode<T>>> {
  public:
   using value_type = T;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
+ private:
+  using Node = ListNode<T>;
+  using NodeBase = ListNodeBase;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using allocator_holder = AllocatorHolder<node_allocator>;
+  using allocator_holder::GetAllocator;
+
+ public:
   /* LIST MEMBER METHODS */
 
-  List() : ListSize(0) {
-    ChainNode = new Node(value_type());
-    ChainNode->next = ChainNode;
-    ChainNode->prev = ChainNode;
+  List() : List(allocator_type()) {}
+
+  explicit List(const allocator_type &alloc) noexcept
+      : allocator_holder(node_allocator(alloc)), ListSize(0) {
+    ChainNode.next = &ChainNode;
+    ChainNode.prev = &ChainNode;
   }
 
-  explicit List(size_type n) : List() {
+  explicit List(size_type n, const allocator_type &alloc = allocator_type())
+      : List(alloc) {
     for (size_type i = 0; i != n; ++i) {
       push_back(value_type());
     }
   }
 
-  List(std::initializer_list<value_type> const &items) : List() {
+  List(std::initializer_list<value_type> const &items,
+       const allocator_type &alloc = allocator_type())
+      : List(alloc) {
     for (const_reference item : items) {
       push_back(item);
     }
   }
 
-  List(const List &other) : List() {
+  List(const List &other)
+      : List(allocator_type(node_traits::select_on_container_copy_construction(
+            other.GetAllocator()))) {
     for (const_reference item : other) {
       push_back(item);
     }
   }
 
-  List(List &&other) noexcept : List() {
-    ListSize = other.ListSize;
-    other.ListSize = 0;
-    std::swap(ChainNode, other.ChainNode);
+  List(List &&other) noexcept
+      : allocator_holder(std::move(other.GetAllocator())), ListSize(0) {
+    ChainNode.next = &ChainNode;
+    ChainNode.prev = &ChainNode;
+    TakeChain(other);
   }
 
-  List<value_type> &operator=(const List<value_type> &other) {
+  List &operator=(const List &other) {
     if (this != &other) {
       clear();
+      allocator_holder::CopyAssignAllocator(other);
       for (const_reference item : other) {
         push_back(item);
       }
@@ -56,37 +100,43 @@ class List {
     return *this;
   }
 
-  List<T> &operator=(List<T> &&other) noexcept {
+  List &operator=(List &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
+    if (this == &other) return *this;
     clear();
-    ListSize = other.ListSize;
-    other.ListSize = 0;
-    std::swap(ChainNode, other.ChainNode);
-
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        allocator_holder::SameAllocator(other)) {
+      allocator_holder::MoveAssignAllocator(other);
+      TakeChain(other);
+    } else {
+      // nodes of other can not be released by our allocator
+      for (reference item : other) {
+        push_back(std::move(item));
+      }
+      other.clear();
+    }
     return *this;
   }
 
   ~List() {
     clear();
-    delete ChainNode;
     ListSize = 0;
   }
 
+  allocator_type get_allocator() const {
+    return allocator_type(GetAllocator());
+  }
+
  private:
   /* PRIVATE ATTRIBUTES */
-  struct Node {
-    value_type value;
-    Node *next;
-    Node *prev;
-    explicit Node(const_reference value)
-        : value(value), next(nullptr), prev(nullptr){};
-  };
   size_type ListSize;
-  Node *ChainNode;
+  NodeBase ChainNode;
 
   /**** LIST ITERATOR ****/
   class ListIterator {
    public:
-    explicit ListIterator(Node *node, Node *chainNode)
+    explicit ListIterator(NodeBase *node, NodeBase *chainNode)
         : CurrentNode(node), ChainNode(chainNode) {}
 
     ListIterator &operator++() {
@@ -101,7 +151,7 @@ class List {
       if (CurrentNode == ChainNode) {
         throw std::runtime_error("Node is out of list");
       }
-      return CurrentNode->value;
+      return static_cast<Node *>(CurrentNode)->value;
     }
     bool operator==(const ListIterator &other) const {
       if (CurrentNode == other.CurrentNode) {
@@ -114,18 +164,18 @@ class List {
       ;
     }
 
-    Node *GetCurrentNode() { return CurrentNode; }
+    NodeBase *GetCurrentNode() { return CurrentNode; }
 
    private:
     /* CurrentNode is a reference to current position of Node in Linked List
      * * ChainNode is a dummy node, reference on virtual Node, that can link
      * begin Node and end Node */
-    Node *CurrentNode;
-    Node *ChainNode;
+    NodeBase *CurrentNode;
+    NodeBase *ChainNode;
   };
   class ListConstIterator {
    public:
-    explicit ListConstIterator(Node *node, Node *ChainNode)
+    explicit ListConstIterator(NodeBase *node, NodeBase *ChainNode)
         : CurrentNode(node), ChainNode(ChainNode) {}
 
     ListConstIterator &operator++() {
@@ -142,7 +192,7 @@ class List {
       if (CurrentNode == ChainNode) {
         throw std::runtime_error("Node is out of list (ChainNode)");
       }
-      return CurrentNode->value;
+      return static_cast<Node *>(CurrentNode)->value;
     }
 
     bool operator==(const ListConstIterator &other) const {
@@ -154,11 +204,11 @@ class List {
       ;
     }
 
-    Node *getCurrentNode() { return CurrentNode; }
+    NodeBase *getCurrentNode() { return CurrentNode; }
 
    private:
-    Node *CurrentNode;
-    Node *ChainNode;
+    NodeBase *CurrentNode;
+    NodeBase *ChainNode;
   };
 
  public:
@@ -170,33 +220,37 @@ class List {
   Returns a reference to the first element in the container.
   Calling front on an empty container causes undefined behavior.
    */
-  reference front() { return ChainNode->next->value; }
-  const_reference front() const { return ChainNode->next->value; }
+  reference front() { return static_cast<Node *>(ChainNode.next)->value; }
+  const_reference front() const {
+    return static_cast<const Node *>(ChainNode.next)->value;
+  }
 
   /*
   Returns a reference to the last element in the container.
   Calling back on an empty container causes undefined behavior.
   */
-  reference back() { return ChainNode->prev->value; }
-  const_reference back() const { return ChainNode->prev->value; }
+  reference back() { return static_cast<Node *>(ChainNode.prev)->value; }
+  const_reference back() const {
+    return static_cast<const Node *>(ChainNode.prev)->value;
+  }
 
   /* Iterator to the first node of list */
-  iterator begin() noexcept { return iterator(ChainNode->next, ChainNode); }
+  iterator begin() noexcept { return iterator(ChainNode.next, &ChainNode); }
   const_iterator begin() const noexcept {
-    return const_iterator(ChainNode->next, ChainNode);
+    return const_iterator(ChainNode.next, Chain());
   }
 
   /* Iterator to the last node of list (actually ChainNode)
    * Real last node is ChainNode.prev */
-  iterator end() noexcept { return iterator(ChainNode, ChainNode); };
+  iterator end() noexcept { return iterator(&ChainNode, &ChainNode); };
   const_iterator end() const noexcept {
-    return const_iterator(ChainNode, ChainNode);
+    return const_iterator(Chain(), Chain());
   };
 
   /* Erase Node on entry position */
   iterator erase(iterator pos) {
-    Node *CurrNode = pos.GetCurrentNode();
-    Node *NextNode = CurrNode->next;
+    NodeBase *CurrNode = pos.GetCurrentNode();
+    NodeBase *NextNode = CurrNode->next;
 
     if (is_ChainNode(pos)) {
       ListSize--;
@@ -210,25 +264,24 @@ class List {
     CurrNode->prev->next = CurrNode->next;
     CurrNode->next->prev = CurrNode->prev;
 
-    delete CurrNode;
+    DestroyNode(static_cast<Node *>(CurrNode));
     ListSize--;
 
-    return iterator(NextNode, ChainNode);
+    return iterator(NextNode, &ChainNode);
   }
 
   /* Insert node in entry position, return position of the next node */
   iterator insert(iterator pos, const_reference value) {
-    Node *NewNode = new Node(value);
-    NewNode->next = pos.GetCurrentNode();
-    NewNode->prev = pos.GetCurrentNode()->prev;
-    pos.GetCurrentNode()->prev->next = NewNode;
-    pos.GetCurrentNode()->prev = NewNode;
-    ListSize++;
-    return iterator(NewNode, ChainNode);
+    return LinkBefore(pos.GetCurrentNode(), CreateNode(value));
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return LinkBefore(pos.GetCurrentNode(), CreateNode(std::move(value)));
   }
 
   /* Push node to the back of list */
   void push_back(const_reference value) { insert(end(), value); }
+  void push_back(value_type &&value) { insert(end(), std::move(value)); }
 
   /* Push node to the front of list */
   void push_front(const_reference value) { insert(begin(), value); }
@@ -243,7 +296,7 @@ class List {
   void pop_front() { erase(begin()); }
 
   /* bool expression that check empty list or not */
-  bool empty() const noexcept { return ChainNode == ChainNode->next; }
+  bool empty() const noexcept { return Chain() == ChainNode.next; }
 
   /* Return size of list */
   size_type size() const noexcept { return ListSize; }
@@ -257,49 +310,69 @@ class List {
 
   /* Clean up list */
   void clear() {
-    Node *CurrNode = ChainNode->next;
-    while (CurrNode != ChainNode) {
-      Node *TempNode = CurrNode;
+    NodeBase *CurrNode = ChainNode.next;
+    while (CurrNode != &ChainNode) {
+      NodeBase *TempNode = CurrNode;
       CurrNode = CurrNode->next;
-      delete TempNode;
+      DestroyNode(static_cast<Node *>(TempNode));
     }
 
-    ChainNode->next = ChainNode;
-    ChainNode->prev = ChainNode;
+    ChainNode.next = &ChainNode;
+    ChainNode.prev = &ChainNode;
     ListSize = 0;
   }
 
-  /* Swap list with other list */
-  void swap(List<T> &other) {
-    std::swap(ChainNode, other.ChainNode);
-    std::swap(ListSize, other.ListSize);
+  /* Swap list with other list. Allocators are exchanged only if they
+   * propagate on swap, otherwise they must compare equal */
+  void swap(List &other) noexcept {
+    if (this == &other) return;
+    allocator_holder::SwapAllocator(other);
+    List tmp(std::move(other));
+    other.TakeChain(*this);
+    TakeChain(tmp);
   }
 
-  /* Other list entry in current list*/
-  void merge(List<value_type> &other) {
-    if (this == &other) {
+  /* Merges sorted other into this sorted list by relinking its nodes.
+   * Stable: equal elements of this list stay ahead of those of other */
+  void merge(List &other) { merge(other, std::less<>()); }
+  void merge(List &&other) { merge(other, std::less<>()); }
+
+  template <typename Compare>
+  void merge(List &other, Compare comp) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+    if (!allocator_holder::SameAllocator(other)) {
+      List adopted = Adopt(other, other.ChainNode.next, other.Chain());
+      merge(adopted, comp);
       return;
     }
 
-    ListSize += other.ListSize;
-    iterator it1 = begin();
-    iterator it2 = other.begin();
-
-    while (it1 != end() && it2 != other.end()) {
-      if (*it1 > *it2) {
-        insert(it1, *it2);
-        ++it2;
+    NodeBase *CurrNode = ChainNode.next;
+    NodeBase *OtherNode = other.ChainNode.next;
+    NodeBase *OtherEnd = other.Chain();
+    while (CurrNode != &ChainNode && OtherNode != OtherEnd) {
+      if (comp(Value(OtherNode), Value(CurrNode))) {
+        // move the whole run of other that goes before CurrNode at once
+        NodeBase *RunEnd = OtherNode->next;
+        while (RunEnd != OtherEnd && comp(Value(RunEnd), Value(CurrNode))) {
+          RunEnd = RunEnd->next;
+        }
+        Transfer(CurrNode, OtherNode, RunEnd);
+        OtherNode = RunEnd;
       } else {
-        ++it1;
+        CurrNode = CurrNode->next;
       }
     }
+    Transfer(&ChainNode, OtherNode, OtherEnd);
 
-    while (it2 != other.end()) {
-      push_back(*it2);
-      ++it2;
-    }
+    ListSize += other.ListSize;
+    other.ListSize = 0;
+  }
 
-    other.clear();
+  template <typename Compare>
+  void merge(List &&other, Compare comp) {
+    merge(other, comp);
   }
 
   /* Reverse current list */
@@ -307,12 +380,12 @@ class List {
     if (ListSize < 2) {
       return;
     }
-    Node *node = ChainNode->next;
-    while (node != ChainNode) {
+    NodeBase *node = ChainNode.next;
+    while (node != &ChainNode) {
       std::swap(node->next, node->prev);
       node = node->prev;
     }
-    std::swap(ChainNode->prev, ChainNode->next);
+    std::swap(ChainNode.prev, ChainNode.next);
   }
 
   /* Removes all  duplicate from the list */
@@ -334,53 +407,250 @@ class List {
     }
   }
 
-  /* Sorts the elements and preserves the order of equivalent elements */
-  void sort() {
+  /* Sorts the elements and preserves the order of equivalent elements.
+   * Bottom-up merge sort that only relinks nodes and never allocates:
+   * bins[i] holds a sorted run of 2^i nodes, every new node is carried
+   * through the bins like a binary counter. If comp throws, all nodes stay
+   * in the list in unspecified order */
+  void sort() { sort(std::less<>()); }
+
+  template <typename Compare>
+  void sort(Compare comp) {
     if (ListSize < 2) return;
 
-    List<value_type> left;
-    List<value_type> right;
+    NodeBase *rest = ChainNode.next;
+    ChainNode.prev->next = nullptr;
+    NodeBase *bins[std::numeric_limits<size_type>::digits] = {};
+    NodeBase *run = nullptr;
+    size_type fill = 0;
+    try {
+      while (rest) {
+        run = rest;
+        rest = rest->next;
+        run->next = nullptr;
+        size_type i = 0;
+        for (; i < fill && bins[i]; ++i) {
+          MergeChains(bins[i], run, comp);
+        }
+        bins[i] = run;
+        run = nullptr;
+        if (i == fill) ++fill;
+      }
+      for (size_type i = 0; i < fill; ++i) {
+        MergeChains(bins[i], run, comp);
+      }
+    } catch (...) {
+      for (size_type i = 0; i < fill; ++i) {
+        run = ConcatChains(run, bins[i]);
+      }
+      RelinkChain(ConcatChains(run, rest));
+      throw;
+    }
+    RelinkChain(run);
+  }
 
-    size_type middle = ListSize / 2;
-    iterator it = begin();
-    for (size_type i = 0; i < middle; ++i) {
-      left.push_back(*it);
-      ++it;
+  /* Transfers all nodes of other before pos in O(1). Nodes are relinked,
+   * not copied, unless the allocators of the lists differ */
+  void splice(iterator pos, List &other) {
+    if (this == &other || other.empty()) {
+      return;
     }
-    while (it != end()) {
-      right.push_back(*it);
-      ++it;
+    if (!allocator_holder::SameAllocator(other)) {
+      List adopted = Adopt(other, other.ChainNode.next, other.Chain());
+      splice(pos, adopted);
+      return;
     }
-
-    // Рекурсивная сортировка обеих половин
-    left.sort();
-    right.sort();
-
-    // Слияние двух отсортированных половин
-    clear();  // Очищаем текущий список
-    *this = left;
-    merge(right);
+    Transfer(pos.GetCurrentNode(), other.ChainNode.next, other.Chain());
+    ListSize += other.ListSize;
+    other.ListSize = 0;
+  }
+  void splice(iterator pos, List &&other) { splice(pos, other); }
+
+  /* Transfers the node at it from other (may be this list) before pos */
+  void splice(iterator pos, List &other, iterator it) {
+    NodeBase *first = it.GetCurrentNode();
+    NodeBase *last = first->next;
+    NodeBase *PosNode = pos.GetCurrentNode();
+    if (PosNode == first || PosNode == last) {
+      return;
+    }
+    SpliceRange(PosNode, other, first, last, 1);
+  }
+  void splice(iterator pos, List &&other, iterator it) {
+    splice(pos, other, it);
   }
 
-  /* Transfers elements from one list to another */
-  void splice(iterator pos, List<T> &other) {
-    if (other.empty()) {
+  /* Transfers [first, last) from other (may be this list) before pos,
+   * linear in the length of the range only to update the sizes */
+  void splice(iterator pos, List &other, iterator first, iterator last) {
+    NodeBase *FirstNode = first.GetCurrentNode();
+    NodeBase *LastNode = last.GetCurrentNode();
+    if (FirstNode == LastNode) {
       return;
     }
-    iterator otherIt = other.begin();
-    while (otherIt != other.end()) {
-      pos = insert(pos, *otherIt);
-      ++pos;
-      ++otherIt;
+    size_type count = 0;
+    if (this != &other) {
+      for (NodeBase *node = FirstNode; node != LastNode; node = node->next) {
+        ++count;
+      }
     }
-    other.clear();
+    SpliceRange(pos.GetCurrentNode(), other, FirstNode, LastNode, count);
+  }
+  void splice(iterator pos, List &&other, iterator first, iterator last) {
+    splice(pos, other, first, last);
   }
 
  private:
   /* PRIVATE ATTRIBUTES */
   bool is_ChainNode(iterator pos) {
-    Node *CurrNode = pos.GetCurrentNode();
-    return CurrNode == ChainNode ? true : false;
+    NodeBase *CurrNode = pos.GetCurrentNode();
+    return CurrNode == &ChainNode ? true : false;
+  }
+
+  NodeBase *Chain() const noexcept {
+    return const_cast<NodeBase *>(&ChainNode);
+  }
+
+  template <typename... Args>
+  Node *CreateNode(Args &&...args) {
+    Node *node = node_traits::allocate(GetAllocator(), 1);
+    try {
+      ::new (static_cast<void *>(node)) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(GetAllocator(), node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void DestroyNode(Node *node) noexcept {
+    node->~Node();
+    node_traits::deallocate(GetAllocator(), node, 1);
+  }
+
+  static reference Value(NodeBase *node) noexcept {
+    return static_cast<Node *>(node)->value;
+  }
+
+  /* Merges the null-terminated sorted chains left and right into right,
+   * nodes of left go first among equal ones. If comp throws, right still
+   * holds every node of both chains */
+  template <typename Compare>
+  static void MergeChains(NodeBase *&left, NodeBase *&right, Compare &comp) {
+    NodeBase head{nullptr, nullptr};
+    NodeBase *tail = &head;
+    NodeBase *first = left;
+    NodeBase *second = right;
+    left = nullptr;
+    try {
+      while (first && second) {
+        if (comp(Value(second), Value(first))) {
+          tail->next = second;
+          second = second->next;
+        } else {
+          tail->next = first;
+          first = first->next;
+        }
+        tail = tail->next;
+      }
+    } catch (...) {
+      tail->next = ConcatChains(first, second);
+      right = head.next;
+      throw;
+    }
+    tail->next = first ? first : second;
+    right = head.next;
+  }
+
+  static NodeBase *ConcatChains(NodeBase *first, NodeBase *second) noexcept {
+    if (!first) return second;
+    NodeBase *tail = first;
+    while (tail->next) tail = tail->next;
+    tail->next = second;
+    return first;
+  }
+
+  /* Makes the null-terminated chain starting at first the content of the
+   * list, restoring prev links */
+  void RelinkChain(NodeBase *first) noexcept {
+    NodeBase *prev = &ChainNode;
+    for (NodeBase *node = first; node; node = node->next) {
+      node->prev = prev;
+      prev->next = node;
+      prev = node;
+    }
+    prev->next = &ChainNode;
+    ChainNode.prev = prev;
+  }
+
+  /* Unlinks [first, last) from its list and links it before pos */
+  static void Transfer(NodeBase *pos, NodeBase *first,
+                       NodeBase *last) noexcept {
+    if (first == last) return;
+    NodeBase *before = first->prev;
+    NodeBase *tail = last->prev;
+    before->next = last;
+    last->prev = before;
+    tail->next = pos;
+    first->prev = pos->prev;
+    pos->prev->next = first;
+    pos->prev = tail;
+  }
+
+  void SpliceRange(NodeBase *pos, List &other, NodeBase *first,
+                   NodeBase *last, size_type count) {
+    if (this != &other && !allocator_holder::SameAllocator(other)) {
+      List adopted = Adopt(other, first, last);
+      Transfer(pos, adopted.ChainNode.next, adopted.Chain());
+      ListSize += adopted.ListSize;
+      adopted.ListSize = 0;
+      return;
+    }
+    Transfer(pos, first, last);
+    if (this != &other) {
+      ListSize += count;
+      other.ListSize -= count;
+    }
+  }
+
+  /* Moves the values of [first, last) of other into new nodes made by our
+   * allocator and destroys the old ones, for lists whose allocators differ */
+  List Adopt(List &other, NodeBase *first, NodeBase *last) {
+    List adopted(get_allocator());
+    while (first != last) {
+      NodeBase *next = first->next;
+      adopted.push_back(std::move(Value(first)));
+      first->prev->next = next;
+      next->prev = first->prev;
+      other.DestroyNode(static_cast<Node *>(first));
+      --other.ListSize;
+      first = next;
+    }
+    return adopted;
+  }
+
+  iterator LinkBefore(NodeBase *pos, NodeBase *NewNode) noexcept {
+    NewNode->next = pos;
+    NewNode->prev = pos->prev;
+    pos->prev->next = NewNode;
+    pos->prev = NewNode;
+    ListSize++;
+    return iterator(NewNode, &ChainNode);
+  }
+
+  /* Moves all nodes of other to this list, this list must be empty.
+   * The ChainNode lives inside the list object, so the first and the last
+   * node are relinked to the new one. */
+  void TakeChain(List &other) noexcept {
+    if (other.empty()) return;
+    ChainNode.next = other.ChainNode.next;
+    ChainNode.prev = other.ChainNode.prev;
+    ChainNode.next->prev = &ChainNode;
+    ChainNode.prev->next = &ChainNode;
+    ListSize = other.ListSize;
+    other.ChainNode.next = &other.ChainNode;
+    other.ChainNode.prev = &other.ChainNode;
+    other.ListSize = 0;
   }
 };
 
@@ -1,124 +1,130 @@
 #ifndef CPPCONTAINERS_MAP_H
 #define CPPCONTAINERS_MAP_H
 
-#include <cstdio>
+#include <functional>
 #include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "s21_vector.h"
 #include "tree/tree.h"
 
 namespace s21 {
 
-template <typename Key, typename T>
-class map : public tree<std::pair<Key, T>> {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          bool Ranked = false>
+class map : public tree<Key, std::pair<const Key, T>, keys::First,
+                        Compare, true, Allocator, Ranked> {
+  using tree_type = tree<Key, std::pair<const Key, T>, keys::First,
+                         Compare, true, Allocator, Ranked>;
+
+ public:
   /* Map Member type */
- private:
-  using tree<std::pair<Key, T>>::tree;
   using key_type = Key;
+  using mapped_type = T;
   using map_type = T;
-  using value_type = std::pair<key_type, map_type>;
+  using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename tree<value_type>::Iterator;
-  using const_iterator = typename tree<value_type>::IteratorConst;
+  using iterator = typename tree_type::Iterator;
+  using const_iterator = typename tree_type::IteratorConst;
   using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
- public:
   /* Member functions */
 
-  map(std::initializer_list<value_type> const& items) : map() {
-    for (value_type value : items) {
-      insert(value.first, value.second);
+  using tree_type::tree_type;
+
+  map() = default;
+  map(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {
+    for (const value_type& value : items) {
+      insert(value);
     }
   }
+  map(std::initializer_list<value_type> const& items, const Allocator& alloc)
+      : map(items, Compare(), alloc) {}
+
+  /* Builds a balanced map from a range sorted by Compare in O(n) */
+  template <typename InputIt>
+  static map from_sorted(InputIt first, InputIt last,
+                         const Compare& comp = Compare(),
+                         const Allocator& alloc = Allocator()) {
+    map result(comp, alloc);
+    result.assign_sorted(first, last);
+    return result;
+  }
 
   /* Map Element access */
 
   [[nodiscard]] map_type& at(const key_type& key) {
-    auto found = find_contains_map(key);
-    if (!found) throw std::out_of_range("There is no such key!");
-    return found->value_.second;
+    iterator found = this->find(key);
+    if (found == this->end()) throw std::out_of_range("There is no such key!");
+    return (*found).second;
   }
 
-  map_type& operator[](const key_type& key) {
-    try {
-      return at(key);
-    } catch (...) {
-      value_type val = value_type(key, map_type());
-      tree<value_type>::default_insert(val);
-      return at(key);
-    }
+  [[nodiscard]] const map_type& at(const key_type& key) const {
+    const_iterator found = this->find(key);
+    if (found == this->end()) throw std::out_of_range("There is no such key!");
+    return (*found).second;
   }
 
-  /* Map Iterators */
+  map_type& operator[](const key_type& key) {
+    return (*try_emplace(key).first).second;
+  }
 
-  /* Map Capacity */
+  map_type& operator[](key_type&& key) {
+    return (*try_emplace(std::move(key)).first).second;
+  }
 
   /* Map Modifiers */
 
+  using tree_type::insert;
+
   std::pair<iterator, bool> insert(const key_type& key, const map_type& obj) {
-    if (contains(key))
-      return std::make_pair(iterator(this->find_contains_map(key)), false);
-    iterator iter = tree<value_type>::default_insert(std::make_pair(key, obj));
-    return std::make_pair(iter, true);
+    return try_emplace(key, obj);
   }
 
-  std::pair<iterator, bool> insert(const value_type& value) override {
-    return insert(value.first, value.second);
+  /* The bool is true if the key was inserted and false if obj was assigned
+   * to an existing element */
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) (*result.first).second = std::forward<M>(obj);
+    return result;
   }
 
-  std::pair<iterator, bool> insert_or_assign(const key_type& key,
-                                             const map_type& obj) {
-    typename tree<value_type>::Node* a = find_contains_map(key);
-    if (a) {
-      a->value_ = std::make_pair(key, obj);
-      return std::make_pair(iterator(a), true);
-    }
-    iterator iter = tree<value_type>::default_insert(std::make_pair(key, obj));
-    return std::make_pair(iter, true);
+  /* Inserts a value built from args unless key is present; in that case
+   * args are left untouched */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+    return this->emplace_at(
+        this->find_insert_position(key), std::piecewise_construct,
+        std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
   }
-  void merge(map& other) { merge_map(other, other.return_root()); }
 
-  /* Map Modifiers */
-
-  [[nodiscard]] bool contains(const key_type& key) noexcept {
-    return find_contains_map(key);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+    return this->emplace_at(
+        this->find_insert_position(key), std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
   }
 
   template <class... Args>
   std::vector<std::pair<iterator, bool>> emplace(Args&&... args) {
-    std::vector<std::pair<iterator, bool>> res = {(insert(args))...};
+    std::vector<std::pair<iterator, bool>> res = {
+        (tree_type::emplace(std::forward<Args>(args)))...};
     return res;
   }
-
- private:
-  typename tree<value_type>::Node* find_contains_map(
-      const key_type& key) noexcept {
-    if (this->empty()) return nullptr;
-    auto* current = tree<value_type>::return_root();
-    while (true) {
-      if (current == nullptr) {
-        return nullptr;
-      } else if (current->value_.first == key) {
-        return current;
-      } else if (current->value_.first > key) {
-        current = current->left_node_;
-      } else {
-        current = current->right_node_;
-      }
-    }
-  }
-
-  void merge_map(map& other, typename tree<value_type>::Node* Node) {
-    if (Node->right_node_) merge_map(other, Node->right_node_);
-    if (Node->left_node_) merge_map(other, Node->left_node_);
-    auto result = insert(Node->value_);
-    if (result.second) {
-      auto iter = iterator(Node);
-      other.erase(iter);
-    }
-  }
 };
 
 }  // namespace s21
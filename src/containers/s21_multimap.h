@@ -0,0 +1,80 @@
+#ifndef CPPCONTAINERS_MULTIMAP_H
+#define CPPCONTAINERS_MULTIMAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "tree/tree.h"
+
+namespace s21 {
+
+/* Ordered map that keeps every inserted pair, elements with equal keys stay
+ * in insertion order */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          bool Ranked = false>
+class multimap : public tree<Key, std::pair<const Key, T>, keys::First,
+                             Compare, false, Allocator, Ranked> {
+  using tree_type = tree<Key, std::pair<const Key, T>, keys::First,
+                         Compare, false, Allocator, Ranked>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::Iterator;
+  using const_iterator = typename tree_type::IteratorConst;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  using tree_type::tree_type;
+
+  multimap() = default;
+  multimap(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {
+    for (const value_type& value : items) {
+      insert(value);
+    }
+  }
+  multimap(std::initializer_list<value_type> const& items,
+           const Allocator& alloc)
+      : multimap(items, Compare(), alloc) {}
+
+  /* Builds a balanced multimap from a range sorted by Compare in O(n) */
+  template <typename InputIt>
+  static multimap from_sorted(InputIt first, InputIt last,
+                              const Compare& comp = Compare(),
+                              const Allocator& alloc = Allocator()) {
+    multimap result(comp, alloc);
+    result.assign_sorted(first, last);
+    return result;
+  }
+
+  iterator insert(const value_type& value) {
+    return tree_type::insert(value).first;
+  }
+
+  iterator insert(const key_type& key, const mapped_type& obj) {
+    return insert(value_type(key, obj));
+  }
+
+  iterator insert(typename tree_type::node_type&& handle) {
+    return tree_type::insert(std::move(handle)).position;
+  }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return tree_type::emplace(std::forward<Args>(args)...).first;
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPPCONTAINERS_MULTIMAP_H
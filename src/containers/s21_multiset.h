@@ -1,73 +1,85 @@
 #ifndef __S21_MULTISET_H__
 #define __S21_MULTISET_H__
 
-#define DEF 0
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
-#include "tree/s21_tree.h"
+#include "tree/tree.h"
 
 namespace s21 {
 
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>, bool Ranked = false>
 class multiset {
  public:
+  using tree_type =
+      s21::tree<Key, Key, keys::Identity, Compare, false, Allocator, Ranked>;
+
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename BinaryTree<Key, int>::iterator;
-  using const_iterator = typename BinaryTree<Key, int>::const_iterator;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_type;
 
   multiset() = default;
-  multiset(std::initializer_list<value_type> const& items) {
+  explicit multiset(const allocator_type& alloc) : tree(alloc) {}
+  explicit multiset(const Compare& comp,
+                    const allocator_type& alloc = allocator_type())
+      : tree(comp, alloc) {}
+  multiset(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const allocator_type& alloc = allocator_type())
+      : tree(comp, alloc) {
     for (const auto& item : items) {
       insert(item);
     }
   }
-
-  multiset(const multiset& ms) {
-    std::pair<Key, int> pair;
-    for (auto it = ms.begin(); it != ms.end(); ++it) {
-      pair = *it;
-      insert(pair.first);
-    }
+  multiset(std::initializer_list<value_type> const& items,
+           const allocator_type& alloc)
+      : multiset(items, Compare(), alloc) {}
+
+  /* Builds a balanced multiset from a range sorted by Compare in O(n) */
+  template <typename InputIt>
+  static multiset from_sorted(InputIt first, InputIt last,
+                              const Compare& comp = Compare(),
+                              const allocator_type& alloc = allocator_type()) {
+    multiset result(comp, alloc);
+    result.tree.assign_sorted(first, last);
+    return result;
   }
-  multiset(multiset&& ms) : tree(std::move(ms.tree)) {}
-  ~multiset() = default;
 
-  multiset& operator=(multiset& s) {
-    if (this != &s) {
-      for (auto it = s.begin(); it != s.end(); ++it) {
-        insert(*it);
-      }
-    }
-    return *this;
-  }
+  multiset(const multiset& ms) = default;
+  multiset(multiset&& ms) = default;
+  ~multiset() = default;
 
-  multiset& operator=(multiset&& ms) {
-    if (this != &ms) {
-      tree = std::move(ms.tree);
-    }
-    return *this;
-  }
+  multiset& operator=(const multiset& ms) = default;
+  multiset& operator=(multiset&& ms) = default;
 
   // Iterators
-  iterator begin() { return tree.begin(); }
-  const_iterator begin() const { return tree.begin(); }
-  iterator end() { return tree.end(); }
-  const_iterator end() const { return tree.end(); }
+  iterator begin() const { return tree.begin(); }
+  iterator end() const { return tree.end(); }
 
   // Capacity
-  bool empty() { return tree.empty(); }
-  size_type size() { return tree.size(); }
-  size_type max_size() { return tree.max_size(); }
+  bool empty() const { return tree.empty(); }
+  size_type size() const { return tree.size(); }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
 
-  // // Modifiers
+  // Modifiers
   void clear() { tree.clear(); }
+  allocator_type get_allocator() const { return tree.get_allocator(); }
+  key_compare key_comp() const { return tree.key_comp(); }
 
   iterator insert(const value_type& value) {
-    auto result = tree.multiInsert(value, DEF);
-    return iterator(result.first);
+    return tree.insert(value).first;
   }
 
   void erase(iterator pos) {
@@ -79,29 +91,56 @@ class multiset {
 
   void swap(multiset& other) { tree.swap(other.tree); }
 
-  void merge(multiset& other) {
-    for (auto&& item : other) {
-      insert(std::move(item));
-    }
-    other.clear();
+  /* Moves every node of other, nothing is allocated or copied */
+  void merge(multiset& other) { tree.merge(other.tree); }
+
+  node_type extract(iterator pos) { return tree.extract(pos); }
+  node_type extract(const Key& key) { return tree.extract(key); }
+  iterator insert(node_type&& handle) {
+    return tree.insert(std::move(handle)).position;
   }
 
-  // // Lookup
-  size_type count(const Key& key) { return tree.count(key); }
-  iterator find(const Key& key) { return tree.find(key); }
-  bool contains(const Key& key) { return tree.find(key) != tree.end(); }
+  // Lookup, K is Key or, with a transparent Compare, any type comparable
+  // with Key
+  template <typename K>
+  size_type count(const K& key) const {
+    return tree.count(key);
+  }
+  template <typename K>
+  iterator find(const K& key) const {
+    return tree.find(key);
+  }
+  template <typename K>
+  bool contains(const K& key) const {
+    return tree.contains(key);
+  }
 
-  std::pair<iterator, iterator> equal_range(const Key& key) {
+  template <typename K>
+  std::pair<iterator, iterator> equal_range(const K& key) const {
     return tree.equal_range(key);
   }
 
-  iterator lower_bound(const Key& key) { return tree.lower_bound(key); }
-  iterator upper_bound(const Key& key) { return tree.upper_bound(key); }
+  template <typename K>
+  iterator lower_bound(const K& key) const {
+    return tree.lower_bound(key);
+  }
+  template <typename K>
+  iterator upper_bound(const K& key) const {
+    return tree.upper_bound(key);
+  }
+
+  // Order statistics, available when Ranked is true
+  iterator nth(size_type k) const { return tree.nth(k); }
+  size_type rank(const Key& key) const { return tree.rank(key); }
+  size_type index(iterator pos) const { return tree.index(pos); }
+  size_type distance(iterator first, iterator last) const {
+    return tree.distance(first, last);
+  }
 
  private:
-  BinaryTree<Key, int> tree;
+  tree_type tree;
 };
 
 }  // namespace s21
 
-#endif  // __S21_MULTISET_H__
\ No newline at end of file
+#endif  // __S21_MULTISET_H__
@@ -0,0 +1,192 @@
+#ifndef CPP2_S21_CONTAINERS_1_S21_POOL_ALLOCATOR_H
+#define CPP2_S21_CONTAINERS_1_S21_POOL_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+/* Free-list pool of equally sized blocks carved from larger chunks.
+ * The block size is fixed by the first single-object allocation, which for
+ * a node container is its node type after rebinding. Other requests (arrays
+ * or different sizes) go straight to operator new, over-aligned types to its
+ * aligned form.
+ * Freed blocks are cached for reuse and returned to the system only when the
+ * pool is destroyed. The pool is not thread-safe: share it between
+ * containers of one list or one thread only. */
+class NodePool {
+ public:
+  struct Stats {
+    std::size_t nodes_live = 0;
+    std::size_t nodes_cached = 0;
+    std::size_t chunks_allocated = 0;
+  };
+
+  /* 16 KiB chunks: a few pages, small enough to stay warm in L2 */
+  static constexpr std::size_t kDefaultChunkBytes = 16 * 1024;
+
+  explicit NodePool(std::size_t chunk_bytes = kDefaultChunkBytes) noexcept
+      : chunk_bytes_(chunk_bytes) {}
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  ~NodePool() {
+    while (chunks_) {
+      Chunk *next = chunks_->next;
+      ::operator delete(static_cast<void *>(chunks_));
+      chunks_ = next;
+    }
+  }
+
+  void *allocate(std::size_t bytes, std::size_t align) {
+    if (!Pooled(bytes, align)) {
+      if (align > alignof(std::max_align_t)) {
+        return ::operator new(bytes, std::align_val_t(align));
+      }
+      return ::operator new(bytes);
+    }
+    if (!free_) {
+      AddChunk();
+    }
+    FreeBlock *block = free_;
+    free_ = block->next;
+    --stats_.nodes_cached;
+    ++stats_.nodes_live;
+    return block;
+  }
+
+  void deallocate(void *p, std::size_t bytes, std::size_t align) noexcept {
+    if (!Pooled(bytes, align)) {
+      if (align > alignof(std::max_align_t)) {
+        ::operator delete(p, bytes, std::align_val_t(align));
+      } else {
+        ::operator delete(p);
+      }
+      return;
+    }
+    FreeBlock *block = static_cast<FreeBlock *>(p);
+    block->next = free_;
+    free_ = block;
+    --stats_.nodes_live;
+    ++stats_.nodes_cached;
+  }
+
+  const Stats &stats() const noexcept { return stats_; }
+  std::size_t block_size() const noexcept { return block_size_; }
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  struct alignas(std::max_align_t) Chunk {
+    Chunk *next;
+  };
+
+  /* Decides whether a request is served by the pool, fixing the block size
+   * on the first eligible request */
+  bool Pooled(std::size_t bytes, std::size_t align) noexcept {
+    if (align > alignof(std::max_align_t)) return false;
+    if (block_size_ == 0) {
+      block_size_ = RoundUp(std::max(bytes, sizeof(FreeBlock)),
+                            alignof(std::max_align_t));
+    }
+    return bytes <= block_size_ &&
+           block_size_ - bytes < alignof(std::max_align_t);
+  }
+
+  /* Allocates one chunk and threads its blocks onto the free list in
+   * address order, so consecutive allocations are adjacent in memory */
+  void AddChunk() {
+    std::size_t count = (chunk_bytes_ - sizeof(Chunk)) / block_size_;
+    if (count == 0) count = 1;
+    void *raw = ::operator new(sizeof(Chunk) + count * block_size_);
+    Chunk *chunk = ::new (raw) Chunk{chunks_};
+    chunks_ = chunk;
+    unsigned char *first = reinterpret_cast<unsigned char *>(chunk + 1);
+    for (std::size_t i = count; i-- > 0;) {
+      FreeBlock *block =
+          ::new (static_cast<void *>(first + i * block_size_)) FreeBlock;
+      block->next = free_;
+      free_ = block;
+    }
+    stats_.nodes_cached += count;
+    ++stats_.chunks_allocated;
+  }
+
+  static constexpr std::size_t RoundUp(std::size_t value,
+                                       std::size_t align) noexcept {
+    return (value + align - 1) / align * align;
+  }
+
+  std::size_t chunk_bytes_;
+  std::size_t block_size_ = 0;
+  FreeBlock *free_ = nullptr;
+  Chunk *chunks_ = nullptr;
+  Stats stats_;
+};
+
+/* Allocator backed by a shared NodePool. A default constructed allocator
+ * owns a fresh pool, copies and rebinds share it, so every node of a
+ * s21::List<T, PoolAllocator<T>> is recycled by the pool of that list.
+ * Passing one pool to several containers gives a per-thread pool. */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  PoolAllocator() : pool_(std::make_shared<NodePool>()) {}
+  explicit PoolAllocator(std::shared_ptr<NodePool> pool) noexcept
+      : pool_(std::move(pool)) {}
+  /* Allocators must stay unchanged when moved from, so moves copy */
+  PoolAllocator(const PoolAllocator &other) noexcept = default;
+  PoolAllocator &operator=(const PoolAllocator &other) noexcept = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept
+      : pool_(other.pool()) {}
+
+  T *allocate(std::size_t n) {
+    if (n != 1) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T *>(pool_->allocate(sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    if (n != 1) {
+      std::allocator<T>().deallocate(p, n);
+      return;
+    }
+    pool_->deallocate(p, sizeof(T), alignof(T));
+  }
+
+  /* A copied container gets a pool of its own */
+  PoolAllocator select_on_container_copy_construction() const {
+    return PoolAllocator();
+  }
+
+  const std::shared_ptr<NodePool> &pool() const noexcept { return pool_; }
+  const NodePool::Stats &stats() const noexcept { return pool_->stats(); }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U> &other) const noexcept {
+    return pool_ == other.pool();
+  }
+  template <typename U>
+  bool operator!=(const PoolAllocator<U> &other) const noexcept {
+    return pool_ != other.pool();
+  }
+
+ private:
+  std::shared_ptr<NodePool> pool_;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_S21_POOL_ALLOCATOR_H
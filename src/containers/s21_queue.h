@@ -4,13 +4,19 @@
 #define CPP2_SRC_S21_QUEUE_H_
 
 #include <initializer_list>
+#include <memory>
+#include <type_traits>
 
 #include "s21_list.h"
+#include "s21_ring_buffer.h"
 #include "stdexcept"
 
 namespace s21 {
 
-template <typename T, typename Parent = s21::List<T>>
+/* FIFO adapter over Parent. The default s21::ring_buffer keeps the
+ * elements in one circular array, so push/pop reuse its slots instead of
+ * allocating a node each; s21::List<T> still works as Parent */
+template <typename T, typename Parent = s21::ring_buffer<T>>
 class Queue {
  public:
   /* LIST MEMBER METHODS */
@@ -23,6 +29,11 @@ class Queue {
 
   Queue(std::initializer_list<value_type> const &items) : container(items) {}
 
+  /* Allocator-extended constructor, the allocator is handed to Parent */
+  template <typename Alloc, typename = std::enable_if_t<
+                                std::uses_allocator_v<Parent, Alloc>>>
+  explicit Queue(const Alloc &alloc) : container(alloc) {}
+
   Queue(const Queue &other) : container(other.container) {}
 
   // Queue(Queue &&other) noexcept : container(std::move(other.container)) {} --
@@ -72,10 +83,9 @@ class Queue {
   void swap(Queue &other) { container.swap(other.container); }
 
  private:
-  /*  container = s21::List<T>
-   *  The private attribute of  s21::Queue is a s21::List object.
-   *  That is the reason why the variable called Parent (cause Queue include
-   * List methods. */
+  /*  container = s21::ring_buffer<T> by default
+   *  The private attribute of s21::Queue is a Parent object that provides
+   *  push_back, pop_front, front and back. */
   Parent container;
 };
 }  // namespace s21
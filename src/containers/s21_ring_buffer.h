@@ -0,0 +1,418 @@
+#ifndef CPP2_S21_CONTAINERS_1_RING_BUFFER_H
+#define CPP2_S21_CONTAINERS_1_RING_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_allocator.h"
+
+namespace s21 {
+
+/* Random access iterator of a ring_buffer. It keeps the unmasked position
+ * head + i, so positions of one buffer order like the element indices
+ * and the slot is found by masking on dereference */
+template <typename T, bool Const>
+class RingBufferIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const T *, T *>;
+  using reference = std::conditional_t<Const, const T &, T &>;
+
+  RingBufferIterator() noexcept = default;
+  RingBufferIterator(T *data, std::size_t mask, std::size_t pos) noexcept
+      : data_(data), mask_(mask), pos_(pos) {}
+  /* iterator converts to const_iterator */
+  template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+  RingBufferIterator(const RingBufferIterator<T, WasConst> &other) noexcept
+      : data_(other.data_), mask_(other.mask_), pos_(other.pos_) {}
+
+  reference operator*() const noexcept { return data_[pos_ & mask_]; }
+  pointer operator->() const noexcept { return data_ + (pos_ & mask_); }
+  reference operator[](difference_type n) const noexcept {
+    return *(*this + n);
+  }
+
+  RingBufferIterator &operator++() noexcept {
+    ++pos_;
+    return *this;
+  }
+  RingBufferIterator operator++(int) noexcept {
+    RingBufferIterator old = *this;
+    ++pos_;
+    return old;
+  }
+  RingBufferIterator &operator--() noexcept {
+    --pos_;
+    return *this;
+  }
+  RingBufferIterator operator--(int) noexcept {
+    RingBufferIterator old = *this;
+    --pos_;
+    return old;
+  }
+  RingBufferIterator &operator+=(difference_type n) noexcept {
+    pos_ += static_cast<std::size_t>(n);
+    return *this;
+  }
+  RingBufferIterator &operator-=(difference_type n) noexcept {
+    pos_ -= static_cast<std::size_t>(n);
+    return *this;
+  }
+  friend RingBufferIterator operator+(RingBufferIterator it,
+                                      difference_type n) noexcept {
+    return it += n;
+  }
+  friend RingBufferIterator operator+(difference_type n,
+                                      RingBufferIterator it) noexcept {
+    return it += n;
+  }
+  friend RingBufferIterator operator-(RingBufferIterator it,
+                                      difference_type n) noexcept {
+    return it -= n;
+  }
+  friend difference_type operator-(const RingBufferIterator &a,
+                                   const RingBufferIterator &b) noexcept {
+    return static_cast<difference_type>(a.pos_ - b.pos_);
+  }
+
+  friend bool operator==(const RingBufferIterator &a,
+                         const RingBufferIterator &b) noexcept {
+    return a.pos_ == b.pos_;
+  }
+  friend bool operator!=(const RingBufferIterator &a,
+                         const RingBufferIterator &b) noexcept {
+    return a.pos_ != b.pos_;
+  }
+  friend bool operator<(const RingBufferIterator &a,
+                        const RingBufferIterator &b) noexcept {
+    return a.pos_ < b.pos_;
+  }
+  friend bool operator>(const RingBufferIterator &a,
+                        const RingBufferIterator &b) noexcept {
+    return b < a;
+  }
+  friend bool operator<=(const RingBufferIterator &a,
+                         const RingBufferIterator &b) noexcept {
+    return !(b < a);
+  }
+  friend bool operator>=(const RingBufferIterator &a,
+                         const RingBufferIterator &b) noexcept {
+    return !(a < b);
+  }
+
+ private:
+  template <typename, bool>
+  friend class RingBufferIterator;
+
+  T *data_ = nullptr;
+  std::size_t mask_ = 0;
+  std::size_t pos_ = 0;
+};
+
+/* Double-ended queue in one contiguous circular array. The capacity is a
+ * power of two, so the slot of element i is (head + i) & (capacity - 1).
+ * Pushing and popping at either end never allocates until the buffer is
+ * full; then the capacity doubles and the elements are moved to the start
+ * of the new array. Storage is only released by the destructor, so a queue
+ * that stays under its peak size runs without touching the allocator.
+ * Growing invalidates iterators and references. */
+template <typename T, typename Allocator = std::allocator<T>>
+class ring_buffer : private AllocatorHolder<Allocator> {
+ public:
+  using value_type = T;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = RingBufferIterator<T, false>;
+  using const_iterator = RingBufferIterator<T, true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+
+  /* Capacity of the first allocation */
+  static constexpr size_type kMinCapacity = 8;
+
+ private:
+  using allocator_holder = AllocatorHolder<Allocator>;
+  using allocator_traits = std::allocator_traits<Allocator>;
+  using allocator_holder::GetAllocator;
+
+ public:
+  ring_buffer() : ring_buffer(allocator_type()) {}
+
+  explicit ring_buffer(const allocator_type &alloc) noexcept
+      : allocator_holder(alloc) {}
+
+  /* The constructors below delegate to ring_buffer(alloc), so the
+   * destructor releases the storage if filling it throws */
+  ring_buffer(std::initializer_list<value_type> const &items,
+              const allocator_type &alloc = allocator_type())
+      : ring_buffer(alloc) {
+    reserve(items.size());
+    for (const_reference item : items) emplace_back(item);
+  }
+
+  ring_buffer(const ring_buffer &other)
+      : ring_buffer(allocator_traits::select_on_container_copy_construction(
+            other.GetAllocator())) {
+    reserve(other.size_);
+    for (const_reference item : other) emplace_back(item);
+  }
+
+  ring_buffer(ring_buffer &&other) noexcept
+      : allocator_holder(std::move(other.GetAllocator())) {
+    steal(other);
+  }
+
+  ~ring_buffer() { release(); }
+
+  ring_buffer &operator=(const ring_buffer &other) {
+    if (this != &other) {
+      if (allocator_traits::propagate_on_container_copy_assignment::value &&
+          !allocator_holder::SameAllocator(other)) {
+        // storage must go back to the allocator that provided it
+        release();
+      }
+      allocator_holder::CopyAssignAllocator(other);
+      clear();
+      reserve(other.size_);
+      for (const_reference item : other) emplace_back(item);
+    }
+    return *this;
+  }
+
+  ring_buffer &operator=(ring_buffer &&other) noexcept(
+      allocator_traits::propagate_on_container_move_assignment::value ||
+      allocator_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    if (allocator_traits::propagate_on_container_move_assignment::value ||
+        allocator_holder::SameAllocator(other)) {
+      release();
+      allocator_holder::MoveAssignAllocator(other);
+      steal(other);
+    } else {
+      // the array of other can not be released by our allocator
+      clear();
+      reserve(other.size_);
+      for (reference item : other) emplace_back(std::move(item));
+      other.clear();
+    }
+    return *this;
+  }
+
+  /* Element access */
+
+  reference front() noexcept { return data_[head_]; }
+  const_reference front() const noexcept { return data_[head_]; }
+  reference back() noexcept { return (*this)[size_ - 1]; }
+  const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+  reference operator[](size_type pos) noexcept {
+    return data_[(head_ + pos) & mask()];
+  }
+  const_reference operator[](size_type pos) const noexcept {
+    return data_[(head_ + pos) & mask()];
+  }
+
+  reference at(size_type pos) {
+    if (pos >= size_) throw std::out_of_range("ring_buffer::at()");
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size_) throw std::out_of_range("ring_buffer::at()");
+    return (*this)[pos];
+  }
+
+  /* Iterators */
+
+  iterator begin() noexcept { return iterator(data_, mask(), head_); }
+  iterator end() noexcept { return iterator(data_, mask(), head_ + size_); }
+  const_iterator begin() const noexcept {
+    return const_iterator(data_, mask(), head_);
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(data_, mask(), head_ + size_);
+  }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  /* Capacity */
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept {
+    return allocator_traits::max_size(GetAllocator());
+  }
+  size_type capacity() const noexcept { return capacity_; }
+
+  /* Grows the capacity to the power of two that holds count elements */
+  void reserve(size_type count) {
+    if (count > capacity_) reallocate(capacity_for(count), false, nullptr);
+  }
+
+  /* Modifiers */
+
+  allocator_type get_allocator() const { return GetAllocator(); }
+
+  /* Destroys the elements and keeps the storage */
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; ++i) destroy((*this)[i]);
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(value_type &&value) { emplace_front(std::move(value)); }
+
+  /* args may refer to an element: the new one is built before the old
+   * array is released */
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      reallocate(next_capacity(), false, [&](T *slot) {
+        ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+      });
+    } else {
+      ::new (static_cast<void *>(data_ + ((head_ + size_) & mask())))
+          T(std::forward<Args>(args)...);
+    }
+    ++size_;
+    return back();
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    if (size_ == capacity_) {
+      reallocate(next_capacity(), true, [&](T *slot) {
+        ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+      });
+    } else {
+      size_type slot = (head_ - 1) & mask();
+      ::new (static_cast<void *>(data_ + slot)) T(std::forward<Args>(args)...);
+      head_ = slot;
+    }
+    ++size_;
+    return front();
+  }
+
+  void pop_back() noexcept {
+    --size_;
+    destroy((*this)[size_]);
+  }
+
+  void pop_front() noexcept {
+    destroy(data_[head_]);
+    head_ = (head_ + 1) & mask();
+    --size_;
+  }
+
+  void swap(ring_buffer &other) noexcept {
+    allocator_holder::SwapAllocator(other);
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+ private:
+  size_type mask() const noexcept { return capacity_ - 1; }
+
+  size_type next_capacity() const {
+    if (capacity_ > max_size() / 2) {
+      throw std::length_error("ring_buffer is too large");
+    }
+    return capacity_ ? capacity_ * 2 : kMinCapacity;
+  }
+
+  size_type capacity_for(size_type count) const {
+    if (count > max_size() / 2) {
+      throw std::length_error("ring_buffer is too large");
+    }
+    size_type capacity = kMinCapacity;
+    while (capacity < count) capacity *= 2;
+    return capacity;
+  }
+
+  static void destroy(T &item) noexcept { item.~T(); }
+
+  /* Moves the elements to the start of a new array of new_capacity slots.
+   * If build is given it constructs one more element in the new array:
+   * behind the others, or in the last slot when in_front is set. Throws
+   * leave the buffer as it was */
+  template <typename Build>
+  void reallocate(size_type new_capacity, bool in_front, Build &&build) {
+    T *new_data = allocator_traits::allocate(GetAllocator(), new_capacity);
+    T *built = nullptr;
+    size_type moved = 0;
+    try {
+      if constexpr (!std::is_same_v<std::decay_t<Build>, std::nullptr_t>) {
+        built = new_data + (in_front ? new_capacity - 1 : size_);
+        build(built);
+      }
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        // the elements are at most two contiguous runs of the old array
+        size_type first_run = std::min(size_, capacity_ - head_);
+        copy_bytes(data_ + head_, first_run, new_data);
+        copy_bytes(data_, size_ - first_run, new_data + first_run);
+        moved = size_;
+      } else {
+        for (; moved < size_; ++moved) {
+          ::new (static_cast<void *>(new_data + moved))
+              T(std::move_if_noexcept((*this)[moved]));
+        }
+      }
+    } catch (...) {
+      for (size_type i = 0; i < moved; ++i) destroy(new_data[i]);
+      if (built) destroy(*built);
+      allocator_traits::deallocate(GetAllocator(), new_data, new_capacity);
+      throw;
+    }
+    size_type count = size_;
+    release();
+    data_ = new_data;
+    capacity_ = new_capacity;
+    size_ = count;
+    head_ = built && in_front ? new_capacity - 1 : 0;
+  }
+
+  static void copy_bytes(const T *first, size_type count, T *dest) noexcept {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(dest), first, count * sizeof(T));
+    }
+  }
+
+  /* Destroys the elements and returns the array to the allocator */
+  void release() noexcept {
+    clear();
+    if (data_) allocator_traits::deallocate(GetAllocator(), data_, capacity_);
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  void steal(ring_buffer &other) noexcept {
+    data_ = std::exchange(other.data_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    head_ = std::exchange(other.head_, 0);
+    size_ = std::exchange(other.size_, 0);
+  }
+
+  T *data_ = nullptr;
+  size_type capacity_ = 0;
+  size_type head_ = 0;
+  size_type size_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_RING_BUFFER_H
@@ -1,71 +1,84 @@
 #ifndef __S21_SET_H__
 #define __S21_SET_H__
 
-#define DEF 0
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
-#include "tree/s21_tree.h"
+#include "tree/tree.h"
 
 namespace s21 {
 
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>, bool Ranked = false>
 class set {
  public:
+  using tree_type =
+      s21::tree<Key, Key, keys::Identity, Compare, true, Allocator, Ranked>;
+
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename BinaryTree<Key, int>::iterator;
-  using const_iterator = typename BinaryTree<Key, int>::const_iterator;
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using node_type = typename tree_type::node_type;
 
   set() = default;
-  set(std::initializer_list<value_type> const& items) {
+  explicit set(const allocator_type& alloc) : tree(alloc) {}
+  explicit set(const Compare& comp,
+               const allocator_type& alloc = allocator_type())
+      : tree(comp, alloc) {}
+  set(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(),
+      const allocator_type& alloc = allocator_type())
+      : tree(comp, alloc) {
     for (const auto& item : items) {
       insert(item);
     }
   }
-  set(set& s) {
-    // std::pair<int, int> pair;
-    for (auto it = s.begin(); it != s.end(); ++it) {
-      insert(*it);
-    }
+  set(std::initializer_list<value_type> const& items,
+      const allocator_type& alloc)
+      : set(items, Compare(), alloc) {}
+
+  /* Builds a balanced set from a range sorted by Compare in O(n) */
+  template <typename InputIt>
+  static set from_sorted(InputIt first, InputIt last,
+                         const Compare& comp = Compare(),
+                         const allocator_type& alloc = allocator_type()) {
+    set result(comp, alloc);
+    result.tree.assign_sorted(first, last);
+    return result;
   }
-  set(set&& s) : tree(std::move(s.tree)) {}
+  set(const set& s) = default;
+  set(set&& s) = default;
   ~set() = default;
 
-  set& operator=(set& s) {
-    if (this != &s) {
-      for (auto it = s.begin(); it != s.end(); ++it) {
-        insert(*it);
-      }
-    }
-    return *this;
-  }
-
-  set& operator=(set&& s) {
-    if (this != &s) {
-      tree = std::move(s.tree);
-    }
-    return *this;
-  }
-
-  Key& operator*(iterator it) const { return std::ref(it.current->key); }
+  set& operator=(const set& s) = default;
+  set& operator=(set&& s) = default;
 
   // Iterators
-  iterator begin() { return tree.begin(); }
-  iterator end() { return tree.end(); }
+  iterator begin() const { return tree.begin(); }
+  iterator end() const { return tree.end(); }
 
   // Capacity
-  bool empty() { return tree.empty(); }
-  size_type size() { return tree.size(); }
-  size_type max_size() { return tree.max_size(); }
+  bool empty() const { return tree.empty(); }
+  size_type size() const { return tree.size(); }
+  size_type max_size() const { return std::numeric_limits<size_type>::max(); }
 
   // Modifiers
   void clear() { tree.clear(); }
+  allocator_type get_allocator() const { return tree.get_allocator(); }
+  key_compare key_comp() const { return tree.key_comp(); }
 
   std::pair<iterator, bool> insert(const value_type& value) {
-    auto result = tree.insert(value, DEF);
-    return std::make_pair(iterator(result.first), result.second);
+    return tree.insert(value);
   }
 
   void erase(iterator pos) {
@@ -77,20 +90,57 @@ class set {
 
   void swap(set& other) { tree.swap(other.tree); }
 
-  void merge(set& other) {
-    for (auto&& item : other) {
-      insert(std::move(item));
-    }
+  /* Moves the nodes of other whose keys are not in this set, the
+   * duplicates stay in other */
+  void merge(set& other) { tree.merge(other.tree); }
+
+  node_type extract(iterator pos) { return tree.extract(pos); }
+  node_type extract(const Key& key) { return tree.extract(key); }
+  typename tree_type::insert_return_type insert(node_type&& handle) {
+    return tree.insert(std::move(handle));
   }
 
-  // Lookup
-  iterator find(const Key& key) { return tree.find(key); }
-  bool contains(const Key& key) { return tree.find(key) != tree.end(); }
+  // Lookup, K is Key or, with a transparent Compare, any type comparable
+  // with Key
+  template <typename K>
+  iterator find(const K& key) const {
+    return tree.find(key);
+  }
+  template <typename K>
+  bool contains(const K& key) const {
+    return tree.contains(key);
+  }
+  template <typename K>
+  size_type count(const K& key) const {
+    return tree.count(key);
+  }
+
+  template <typename K>
+  std::pair<iterator, iterator> equal_range(const K& key) const {
+    return tree.equal_range(key);
+  }
+
+  template <typename K>
+  iterator lower_bound(const K& key) const {
+    return tree.lower_bound(key);
+  }
+  template <typename K>
+  iterator upper_bound(const K& key) const {
+    return tree.upper_bound(key);
+  }
+
+  // Order statistics, available when Ranked is true
+  iterator nth(size_type k) const { return tree.nth(k); }
+  size_type rank(const Key& key) const { return tree.rank(key); }
+  size_type index(iterator pos) const { return tree.index(pos); }
+  size_type distance(iterator first, iterator last) const {
+    return tree.distance(first, last);
+  }
 
  private:
-  BinaryTree<Key, int> tree;
+  tree_type tree;
 };
 
 }  // namespace s21
 
-#endif  // __S21_SET_H__
\ No newline at end of file
+#endif  // __S21_SET_H__
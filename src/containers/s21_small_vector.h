@@ -0,0 +1,84 @@
+#ifndef CPP2_S21_CONTAINERS_1_SMALL_VECTOR_H
+#define CPP2_S21_CONTAINERS_1_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+
+#include "s21_vector.h"
+
+namespace s21 {
+namespace growth {
+/* Growth policy that owns raw storage for the first N elements.
+ * s21::Vector detects kInlineCapacity and uses InlineData() as its initial
+ * buffer, Base decides how to grow once the buffer spills to the heap.
+ * Copying or moving the policy never touches the buffer itself: elements
+ * are managed by the vector only. */
+template <typename T, std::size_t N, typename Base = Double>
+class InlineBuffer : public Base {
+ public:
+  static constexpr std::size_t kInlineCapacity = N;
+
+  InlineBuffer() = default;
+  InlineBuffer(const InlineBuffer &other) : Base(other) {}
+  InlineBuffer(InlineBuffer &&other) noexcept
+      : Base(static_cast<Base &&>(other)) {}
+  InlineBuffer &operator=(const InlineBuffer &other) {
+    Base::operator=(other);
+    return *this;
+  }
+  InlineBuffer &operator=(InlineBuffer &&other) noexcept {
+    Base::operator=(static_cast<Base &&>(other));
+    return *this;
+  }
+  ~InlineBuffer() = default;
+
+  T *InlineData() noexcept { return reinterpret_cast<T *>(buffer_); }
+  const T *InlineData() const noexcept {
+    return reinterpret_cast<const T *>(buffer_);
+  }
+
+ private:
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+}  // namespace growth
+
+/* s21::Vector that keeps up to N elements inside the object and allocates
+ * only when it grows beyond them. Shrinking a spilled vector back to N or
+ * fewer elements with shrink_to_fit() returns it to the inline buffer. */
+template <typename T, std::size_t N, typename GrowthPolicy = growth::Double,
+          typename Allocator = std::allocator<T>>
+class SmallVector
+    : public Vector<T, growth::InlineBuffer<T, N, GrowthPolicy>, Allocator> {
+  static_assert(N > 0, "SmallVector needs a non-zero inline capacity");
+  using vector_type =
+      Vector<T, growth::InlineBuffer<T, N, GrowthPolicy>, Allocator>;
+
+ public:
+  using typename vector_type::allocator_type;
+  using typename vector_type::const_iterator;
+  using typename vector_type::const_reference;
+  using typename vector_type::iterator;
+  using typename vector_type::reference;
+  using typename vector_type::size_type;
+  using typename vector_type::value_type;
+
+  using vector_type::vector_type;
+
+  SmallVector() = default;
+  SmallVector(std::initializer_list<value_type> const &items,
+              const allocator_type &alloc = allocator_type())
+      : vector_type(items, alloc) {}
+
+  /* Capacity served without a heap allocation */
+  static constexpr size_type inline_capacity() noexcept { return N; }
+
+  /* True while elements live in the inline buffer */
+  bool is_inline() const noexcept {
+    return this->data() == this->growth_policy().InlineData();
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_SMALL_VECTOR_H
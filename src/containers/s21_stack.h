@@ -3,15 +3,16 @@
 
 #include <cstdio>
 #include <initializer_list>
+#include <memory>
 
 #include "s21_list.h"
 
 namespace s21 {
 
-template <typename T>
-class stack : protected s21::List<T> {
+template <typename T, typename Allocator = std::allocator<T>>
+class stack : protected s21::List<T, Allocator> {
  private:
-  using stack_type = s21::List<T>;
+  using stack_type = s21::List<T, Allocator>;
 
   /* Stack Member type */
   using value_type = typename stack_type::value_type;
@@ -20,16 +21,22 @@ class stack : protected s21::List<T> {
   using size_type = typename stack_type::size_type;
 
  public:
+  using allocator_type = typename stack_type::allocator_type;
+
   /* Stack Member type */
   using stack_type::stack_type;
 
   /* Stack Member functions */
-  stack(std::initializer_list<value_type> const &items) : stack() {
+  stack(std::initializer_list<value_type> const &items,
+        const allocator_type &alloc = allocator_type())
+      : stack_type(alloc) {
     for (value_type value : items) {
       stack_type::push_front(value);
     }
   }
 
+  using stack_type::get_allocator;
+
   /* Stack Element access */
   [[nodiscard]] const_reference top() const noexcept {
     return stack_type::front();
@@ -0,0 +1,109 @@
+#ifndef CPP2_S21_CONTAINERS_1_UNORDERED_MAP_H
+#define CPP2_S21_CONTAINERS_1_UNORDERED_MAP_H
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "hash/hash_table.h"
+
+namespace s21 {
+
+/* Hash map with the interface of s21::map, stored in an open-addressing
+ * hash_table: lookups take O(1) probes of flat arrays instead of O(log n)
+ * node hops. Growing the table moves the elements, see hash_table */
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map
+    : public hash_table<Key, std::pair<const Key, T>, keys::First, Hash,
+                        KeyEqual, Allocator> {
+  using table_type = hash_table<Key, std::pair<const Key, T>, keys::First,
+                                Hash, KeyEqual, Allocator>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  /* Member functions */
+
+  using table_type::table_type;
+
+  unordered_map() = default;
+  unordered_map(std::initializer_list<value_type> const& items,
+                size_type bucket_count = 0, const Hash& hash = Hash(),
+                const KeyEqual& equal = KeyEqual(),
+                const Allocator& alloc = Allocator())
+      : table_type(bucket_count, hash, equal, alloc) {
+    this->reserve(items.size());
+    for (const value_type& value : items) insert(value);
+  }
+
+  /* Element access */
+
+  [[nodiscard]] T& at(const Key& key) {
+    iterator found = this->find(key);
+    if (found == this->end()) throw std::out_of_range("There is no such key!");
+    return found->second;
+  }
+  [[nodiscard]] const T& at(const Key& key) const {
+    const_iterator found = this->find(key);
+    if (found == this->end()) throw std::out_of_range("There is no such key!");
+    return found->second;
+  }
+
+  T& operator[](const Key& key) { return try_emplace(key).first->second; }
+  T& operator[](Key&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  /* Modifiers */
+
+  using table_type::insert;
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return try_emplace(key, obj);
+  }
+
+  /* The bool is true if the key was inserted and false if obj was assigned
+   * to an existing element */
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+    std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  /* Inserts a value built from args unless key is present; in that case
+   * args are left untouched */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+    return this->emplace_at(
+        this->find_insert_position(key), std::piecewise_construct,
+        std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+    return this->emplace_at(
+        this->find_insert_position(key), std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UNORDERED_MAP_H
@@ -0,0 +1,112 @@
+#ifndef CPP2_S21_CONTAINERS_1_UNORDERED_SET_H
+#define CPP2_S21_CONTAINERS_1_UNORDERED_SET_H
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "hash/hash_table.h"
+
+namespace s21 {
+
+/* Hash set with the interface of s21::set, stored in an open-addressing
+ * hash_table. Growing the table moves the elements, see hash_table */
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class unordered_set {
+ public:
+  using table_type =
+      s21::hash_table<Key, Key, keys::Identity, Hash, KeyEqual, Allocator>;
+
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+  unordered_set() = default;
+  explicit unordered_set(const allocator_type& alloc) : table(alloc) {}
+  explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual(),
+                         const allocator_type& alloc = allocator_type())
+      : table(bucket_count, hash, equal, alloc) {}
+  unordered_set(std::initializer_list<value_type> const& items,
+                size_type bucket_count = 0, const Hash& hash = Hash(),
+                const KeyEqual& equal = KeyEqual(),
+                const allocator_type& alloc = allocator_type())
+      : table(bucket_count, hash, equal, alloc) {
+    table.reserve(items.size());
+    for (const auto& item : items) {
+      insert(item);
+    }
+  }
+
+  // Iterators
+  iterator begin() const { return table.begin(); }
+  iterator end() const { return table.end(); }
+
+  // Capacity
+  bool empty() const { return table.empty(); }
+  size_type size() const { return table.size(); }
+  size_type max_size() const { return table.max_size(); }
+
+  // Hash policy
+  size_type bucket_count() const { return table.bucket_count(); }
+  float load_factor() const { return table.load_factor(); }
+  float max_load_factor() const { return table.max_load_factor(); }
+  void max_load_factor(float load) { table.max_load_factor(load); }
+  void reserve(size_type count) { table.reserve(count); }
+  void rehash(size_type count) { table.rehash(count); }
+
+  // Modifiers
+  void clear() { table.clear(); }
+  allocator_type get_allocator() const { return table.get_allocator(); }
+  hasher hash_function() const { return table.hash_function(); }
+  key_equal key_eq() const { return table.key_eq(); }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return table.insert(value);
+  }
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return table.insert(std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return table.emplace(std::forward<Args>(args)...);
+  }
+
+  iterator erase(iterator pos) {
+    if (pos == table.end()) {
+      throw std::out_of_range("unordered_set::erase()");
+    }
+    return table.erase(pos);
+  }
+  size_type erase(const Key& key) { return table.erase(key); }
+
+  void swap(unordered_set& other) { table.swap(other.table); }
+
+  /* Moves the keys of other that are missing here, the duplicates stay in
+   * other */
+  void merge(unordered_set& other) { table.merge(other.table); }
+
+  // Lookup
+  iterator find(const Key& key) const { return table.find(key); }
+  bool contains(const Key& key) const { return table.contains(key); }
+  size_type count(const Key& key) const { return table.count(key); }
+
+ private:
+  table_type table;
+};
+
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_UNORDERED_SET_H
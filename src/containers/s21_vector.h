@@ -1,16 +1,106 @@
 #ifndef CPP2_S21_CONTAINERS_1_MASTER_VECTOR_H
 #define CPP2_S21_CONTAINERS_1_MASTER_VECTOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <iostream>  //std::endl
+#include <iterator>
 #include <limits>
+#include <memory>  //std::uninitialized_*, std::allocator_traits
+#include <new>
+#include <type_traits>
+#include <utility>
 
+#include "s21_allocator.h"
 #include "stdexcept"
 
 namespace s21 {
-template <typename T>
-class Vector {
+namespace growth {
+/* Growth policies of s21::Vector.
+ * Grow(capacity, required, value_size) returns the capacity to reallocate
+ * to once required elements no longer fit, OnReallocate(bytes) is told
+ * how many bytes of live elements every reallocation relocated. */
+
+/* Doubles the capacity (the classic std::vector behaviour) */
+struct Double {
+  static std::size_t Grow(std::size_t capacity, std::size_t required,
+                          std::size_t) noexcept {
+    return std::max(required, capacity == 0 ? std::size_t(1) : capacity * 2);
+  }
+  void OnReallocate(std::size_t) noexcept {}
+};
+
+/* Grows by half of the capacity: at most 50% of slack, freed blocks can be
+ * reused by later reallocations */
+struct Factor15 {
+  static std::size_t Grow(std::size_t capacity, std::size_t required,
+                          std::size_t) noexcept {
+    return std::max(required, capacity + capacity / 2 + 1);
+  }
+  void OnReallocate(std::size_t) noexcept {}
+};
+
+/* Grows by a constant number of elements, slack never exceeds Chunk */
+template <std::size_t Chunk>
+struct FixedChunk {
+  static_assert(Chunk > 0, "growth::FixedChunk needs a non-zero chunk");
+  static std::size_t Grow(std::size_t capacity, std::size_t required,
+                          std::size_t) noexcept {
+    std::size_t next = std::max(required, capacity + 1);
+    return (next + Chunk - 1) / Chunk * Chunk;
+  }
+  void OnReallocate(std::size_t) noexcept {}
+};
+
+/* Rounds the capacity chosen by Base up to whole pages, so the allocator
+ * hands out exactly mapped memory for large buffers */
+template <typename Base = Factor15, std::size_t PageSize = 4096>
+struct PageAligned : Base {
+  static_assert((PageSize & (PageSize - 1)) == 0,
+                "growth::PageAligned needs a power of two page size");
+  static std::size_t Grow(std::size_t capacity, std::size_t required,
+                          std::size_t value_size) noexcept {
+    std::size_t next = Base::Grow(capacity, required, value_size);
+    std::size_t bytes = (next * value_size + PageSize - 1) & ~(PageSize - 1);
+    return std::max(next, bytes / value_size);
+  }
+};
+
+/* Number of elements a policy keeps inside the vector object (0 if none) */
+template <typename Policy, typename = void>
+struct InlineCapacity : std::integral_constant<std::size_t, 0> {};
+
+template <typename Policy>
+struct InlineCapacity<Policy, std::void_t<decltype(Policy::kInlineCapacity)>>
+    : std::integral_constant<std::size_t, Policy::kInlineCapacity> {};
+
+/* Wraps any policy and counts reallocations and relocated bytes */
+template <typename Base = Double>
+class Counted : public Base {
+ public:
+  void OnReallocate(std::size_t bytes) noexcept {
+    Base::OnReallocate(bytes);
+    ++reallocations_;
+    bytes_moved_ += bytes;
+  }
+
+  std::size_t reallocations() const noexcept { return reallocations_; }
+  std::size_t bytes_moved() const noexcept { return bytes_moved_; }
+  void reset() noexcept { reallocations_ = bytes_moved_ = 0; }
+
+ private:
+  std::size_t reallocations_ = 0;
+  std::size_t bytes_moved_ = 0;
+};
+}  // namespace growth
+
+/* GrowthPolicy and Allocator are kept as empty bases, stateless ones cost
+ * nothing */
+template <typename T, typename GrowthPolicy = growth::Double,
+          typename Allocator = std::allocator<T>>
+class Vector : private GrowthPolicy, private AllocatorHolder<Allocator> {
  public:
   /*  PUBLIC ATTRIBUTES */
   using value_type = T;
@@ -19,35 +109,79 @@ class Vector {
   using iterator = value_type *;
   using const_iterator = const value_type *;
   using size_type = std::size_t;
+  using growth_policy_type = GrowthPolicy;
+  using allocator_type = Allocator;
+
+ private:
+  template <typename It>
+  using RequireIterator =
+      std::enable_if_t<std::is_base_of_v<
+          std::input_iterator_tag,
+          typename std::iterator_traits<It>::iterator_category>>;
 
+  template <typename It>
+  static constexpr bool kForwardIterator = std::is_base_of_v<
+      std::forward_iterator_tag,
+      typename std::iterator_traits<It>::iterator_category>;
+
+  using allocator_holder = AllocatorHolder<Allocator>;
+  using allocator_traits = std::allocator_traits<Allocator>;
+  using allocator_holder::GetAllocator;
+
+ public:
   /* VECTOR MEMBER FUNCTIONS */
-  Vector() : vSize(0U), vCapacity(0U), vArr(nullptr) {}
+  Vector() : Vector(allocator_type()) {}
 
-  explicit Vector(size_type n)
-      : vSize(n), vCapacity(n), vArr(n ? new value_type[n]() : nullptr) {}
+  explicit Vector(const allocator_type &alloc) noexcept
+      : allocator_holder(alloc), vSize(0U), vCapacity(0U), vArr(nullptr) {
+    ResetStorage();
+  }
 
-  Vector(std::initializer_list<value_type> const &items)
-      : vSize(items.size()), vCapacity(items.size()) {
-    vArr = new value_type[items.size()]();
-    size_t i = 0;
-    for (auto it = items.begin(); it != items.end(); ++it) {
-      at(i) = *it;
-      ++i;
-    }
+  /* The constructors below delegate to Vector(alloc), so the destructor
+   * releases the storage if filling it throws */
+  explicit Vector(size_type n, const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    InitStorage(n);
+    std::uninitialized_value_construct_n(vArr, n);
+    vSize = n;
+  }
+
+  Vector(std::initializer_list<value_type> const &items,
+         const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    InitStorage(items.size());
+    std::uninitialized_copy(items.begin(), items.end(), vArr);
+    vSize = items.size();
+  }
+
+  Vector(size_type n, const_reference value,
+         const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    assign(n, value);
+  }
+
+  template <typename InputIt, typename = RequireIterator<InputIt>>
+  Vector(InputIt first, InputIt last,
+         const allocator_type &alloc = allocator_type())
+      : Vector(alloc) {
+    assign(first, last);
   }
 
   Vector(const Vector &v)
-      : vSize(v.vSize),
-        vCapacity(v.vCapacity),
-        vArr(new value_type[v.vSize]()) {
+      : Vector(allocator_traits::select_on_container_copy_construction(
+            v.GetAllocator())) {
+    InitStorage(v.vSize);
     CopyEntryVector(v);
   }
 
-  Vector(Vector &&other) noexcept
-      : vSize(other.vSize), vCapacity(other.vCapacity), vArr(other.vArr) {
-    other.vSize = 0U;
-    other.vCapacity = 0U;
-    other.vArr = nullptr;
+  Vector(Vector &&other) noexcept(kNothrowSteal)
+      : GrowthPolicy(static_cast<GrowthPolicy &&>(other)),
+        allocator_holder(std::move(other.GetAllocator())),
+        vSize(0U),
+        vCapacity(0U),
+        vArr(nullptr) {
+    ResetStorage();
+    StealStorage(other);
   }
 
   ~Vector() {
@@ -59,23 +193,52 @@ class Vector {
 
   Vector &operator=(const Vector &other) {
     if (this != &other) {
-      clear();
-      vSize = other.vSize;
-      vCapacity = other.vCapacity;
-      vArr = new value_type[vSize]();
-      CopyEntryVector(other);
+      if (allocator_traits::propagate_on_container_copy_assignment::value &&
+          !allocator_holder::SameAllocator(other)) {
+        // storage must go back to the allocator that provided it
+        CleanArr();
+        ResetStorage();
+      }
+      allocator_holder::CopyAssignAllocator(other);
+      if (other.vSize > vCapacity) {
+        Vector copy(other.vArr, other.vArr + other.vSize, GetAllocator());
+        SwapStorage(copy);
+      } else if constexpr (kTriviallyCopyable) {
+        CopyBytes(other.vArr, other.vArr + other.vSize, vArr);
+        vSize = other.vSize;
+      } else if (other.vSize > vSize) {
+        std::copy(other.vArr, other.vArr + vSize, vArr);
+        std::uninitialized_copy(other.vArr + vSize, other.vArr + other.vSize,
+                                vArr + vSize);
+        vSize = other.vSize;
+      } else {
+        std::copy(other.vArr, other.vArr + other.vSize, vArr);
+        DestroyRange(vArr + other.vSize, vArr + vSize);
+        vSize = other.vSize;
+      }
     }
     return *this;
   }
 
-  Vector &operator=(Vector &&other) noexcept {
-    CleanArr();
-    vSize = other.vSize;
-    vCapacity = other.vCapacity;
-    vArr = other.vArr;
-    other.vArr = nullptr;
-    other.vSize = 0U;
-    other.vCapacity = 0U;
+  Vector &operator=(Vector &&other) noexcept(
+      kNothrowSteal &&
+      (allocator_traits::propagate_on_container_move_assignment::value ||
+       allocator_traits::is_always_equal::value)) {
+    if (this == &other) return *this;
+    if (allocator_traits::propagate_on_container_move_assignment::value ||
+        allocator_holder::SameAllocator(other)) {
+      CleanArr();
+      ResetStorage();
+      allocator_holder::MoveAssignAllocator(other);
+      // as in the move constructor, inline buffers are not part of this
+      static_cast<GrowthPolicy &>(*this) = static_cast<GrowthPolicy &&>(other);
+      StealStorage(other);
+    } else {
+      // the buffer of other can not be released by our allocator
+      assign(std::make_move_iterator(other.begin()),
+             std::make_move_iterator(other.end()));
+      other.clear();
+    }
     return *this;
   }
 
@@ -123,86 +286,258 @@ class Vector {
 
   size_type capacity() const noexcept { return vCapacity; }
 
+  /* Only allocates raw storage: no element of the new tail is constructed */
   void reserve(size_type size) {
     if (size > vCapacity) {
-      auto new_data = new value_type[size]();
-
-      for (size_type i = 0; i < vSize; ++i) {
-        new_data[i] = std::move(vArr[i]);
-      }
-
-      CleanArr();
-      vArr = new_data;
-      vCapacity = size;
+      if (size > max_size()) throw std::length_error("Vector::reserve");
+      Reallocate(size);
     }
   }
 
   void shrink_to_fit() {
+    if (UsesInlineStorage()) return;
     if (vCapacity > vSize) {
-      auto new_data = new value_type[vSize]();
+      Reallocate(vSize);
+    }
+  }
 
-      for (size_type i = 0; i < vSize; ++i) {
-        new_data[i] = std::move(vArr[i]);
-      }
+  /* Value-initializes appended elements, destroys removed ones */
+  void resize(size_type count) {
+    if (count <= vSize) {
+      EraseTail(count);
+      return;
+    }
+    if (count > vCapacity) Reallocate(NextCapacity(count));
+    std::uninitialized_value_construct(vArr + vSize, vArr + count);
+    vSize = count;
+  }
 
-      CleanArr();
-      vArr = new_data;
-      vCapacity = vSize;
+  void resize(size_type count, const_reference value) {
+    if (count <= vSize) {
+      EraseTail(count);
+      return;
     }
+    value_type copy(value);
+    if (count > vCapacity) Reallocate(NextCapacity(count));
+    std::uninitialized_fill(vArr + vSize, vArr + count, copy);
+    vSize = count;
   }
 
   /* VECTOR MODIFIERS */
 
+  /* Destroys live elements, keeps allocated storage */
   void clear() noexcept {
-    CleanArr();
-    vArr = nullptr;
+    DestroyRange(vArr, vArr + vSize);
     vSize = 0;
   }
 
-  iterator insert(iterator pos, const_reference value) {
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(const_iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value) {
+    value_type copy(value);
+    return InsertRange(pos, FillIterator(&copy, 0), FillIterator(&copy, count),
+                       count);
+  }
+
+  /* Forward ranges are inserted with one shift of the tail and at most one
+   * reallocation; single-pass ranges are appended and rotated into place.
+   * [first, last) must not point into this vector. */
+  template <typename InputIt, typename = RequireIterator<InputIt>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    if constexpr (kForwardIterator<InputIt>) {
+      return InsertRange(pos, first, last,
+                         static_cast<size_type>(std::distance(first, last)));
+    } else {
+      size_type index = pos - begin();
+      size_type old_size = vSize;
+      for (; first != last; ++first) emplace_back(*first);
+      std::rotate(vArr + index, vArr + old_size, vArr + vSize);
+      return begin() + index;
+    }
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<value_type> items) {
+    return insert(pos, items.begin(), items.end());
+  }
+
+  /* Constructs element from args directly in its final slot when it is
+   * appended or the vector grows; otherwise shifts the tail by one */
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
     size_type index = 0;
     if (vSize != 0) {
       index = pos - begin();  // when vSize = 0, begin() can be ub
     }
 
     if (vCapacity == vSize) {
-      if (vCapacity == 0) {
-        reserve(1);
+      // args may refer to elements of the old buffer, so it is built first
+      size_type new_capacity = NextCapacity(vSize + 1);
+      T *new_data = AllocateStorage(new_capacity);
+      try {
+        ::new (static_cast<void *>(new_data + index))
+            value_type(std::forward<Args>(args)...);
+      } catch (...) {
+        DeallocateStorage(new_data, new_capacity);
+        throw;
+      }
+      try {
+        RelocateRange(vArr, vArr + index, new_data);
+      } catch (...) {
+        new_data[index].~value_type();
+        DeallocateStorage(new_data, new_capacity);
+        throw;
+      }
+      try {
+        RelocateRange(vArr + index, vArr + vSize, new_data + index + 1);
+      } catch (...) {
+        DestroyRange(new_data, new_data + index + 1);
+        DeallocateStorage(new_data, new_capacity);
+        throw;
+      }
+      AdoptStorage(new_data, vSize + 1, new_capacity);
+    } else if (index == vSize) {
+      ::new (static_cast<void *>(vArr + vSize))
+          value_type(std::forward<Args>(args)...);
+      ++vSize;
+    } else {
+      value_type tmp(std::forward<Args>(args)...);
+      if constexpr (kTriviallyCopyable) {
+        std::memmove(static_cast<void *>(vArr + index + 1), vArr + index,
+                     (vSize - index) * sizeof(T));
+        ::new (static_cast<void *>(vArr + index)) value_type(std::move(tmp));
+        ++vSize;
       } else {
-        reserve(vCapacity * 2);
+        ::new (static_cast<void *>(vArr + vSize))
+            value_type(std::move(vArr[vSize - 1]));
+        ++vSize;
+        std::move_backward(vArr + index, vArr + vSize - 2, vArr + vSize - 1);
+        vArr[index] = std::move(tmp);
       }
     }
-    ++vSize;
-    for (size_type i = vSize - 1; i > index; --i) {
-      at(i) = std::move(at(i - 1));
-    }
-    at(index) = value;
 
     return begin() + index;
   }
 
+  /* Inserts every argument as a new element before pos, keeping their order.
+   * Elements are appended in place and rotated into position once
+   * (trivially copyable ones are shifted with one memmove instead). */
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args) {
+    size_type index = 0;
+    if (vSize != 0) {
+      index = pos - begin();  // when vSize = 0, begin() can be ub
+    }
+    constexpr size_type count = sizeof...(args);
+    if constexpr (kTriviallyCopyable && count != 0) {
+      // copies are taken before the buffer moves, then a single memmove
+      const value_type items[] = {value_type(std::forward<Args>(args))...};
+      if (vSize + count > vCapacity) {
+        reserve(NextCapacity(vSize + count));
+      }
+      std::memmove(static_cast<void *>(vArr + index + count), vArr + index,
+                   (vSize - index) * sizeof(T));
+      CopyBytes(items, items + count, vArr + index);
+      vSize += count;
+    } else {
+      size_type old_size = vSize;
+      insert_many_back(std::forward<Args>(args)...);
+      std::rotate(vArr + index, vArr + old_size, vArr + vSize);
+    }
+    return begin() + index;
+  }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    constexpr size_type count = sizeof...(args);
+    if (vSize + count <= vCapacity) {
+      (emplace_back(std::forward<Args>(args)), ...);
+      return;
+    }
+    // args may refer to elements of the old buffer, so they are built first
+    size_type new_capacity = NextCapacity(vSize + count);
+    T *new_data = AllocateStorage(new_capacity);
+    T *tail = new_data + vSize;
+    size_type built = 0;
+    try {
+      ((::new (static_cast<void *>(tail + built))
+            value_type(std::forward<Args>(args)),
+        ++built),
+       ...);
+      RelocateRange(vArr, vArr + vSize, new_data);
+    } catch (...) {
+      DestroyRange(tail, tail + built);
+      DeallocateStorage(new_data, new_capacity);
+      throw;
+    }
+    AdoptStorage(new_data, vSize + count, new_capacity);
+  }
+
   iterator erase(const_iterator pos) {
     size_type index = 0;
     if (vSize != 0) {
       index = pos - begin();  // when vSize = 0, begin() can be ub
     }
-    for (size_type i = index; i < vSize - 1; ++i) {
-      at(i) = std::move(at(i + 1));
+    MoveLeft(vArr + index + 1, vArr + vSize, vArr + index);
+    pop_back();
+    return begin() + index;
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = first - begin();
+    if (first != last) {
+      size_type count = last - first;
+      MoveLeft(vArr + index + count, vArr + vSize, vArr + index);
+      EraseTail(vSize - count);
     }
-    --vSize;
     return begin() + index;
   }
 
-  void push_back(const_reference value) {
+  void assign(size_type count, const_reference value) {
+    value_type copy(value);
+    clear();
+    if (count > vCapacity) Reallocate(count);
+    std::uninitialized_fill_n(vArr, count, copy);
+    vSize = count;
+  }
+
+  template <typename InputIt, typename = RequireIterator<InputIt>>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    if constexpr (kForwardIterator<InputIt>) {
+      size_type count = static_cast<size_type>(std::distance(first, last));
+      if (count > vCapacity) Reallocate(count);
+      std::uninitialized_copy(first, last, vArr);
+      vSize = count;
+    } else {
+      for (; first != last; ++first) emplace_back(*first);
+    }
+  }
+
+  void assign(std::initializer_list<value_type> items) {
+    assign(items.begin(), items.end());
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
     if (vCapacity == vSize) {
-      if (vCapacity == 0) {
-        reserve(1);
-      } else {
-        reserve(vCapacity * 2);
-      }
+      emplace(end(), std::forward<Args>(args)...);
+    } else {
+      ::new (static_cast<void *>(vArr + vSize))
+          value_type(std::forward<Args>(args)...);
+      ++vSize;
     }
-    ++vSize;
-    at(vSize - 1) = value;
+    return back();
   }
 
   void pop_back() {
@@ -212,26 +547,302 @@ class Vector {
     }
   }
 
-  void swap(Vector &other) {
-    std::swap(vArr, other.vArr);
-    std::swap(vSize, other.vSize);
-    std::swap(vCapacity, other.vCapacity);
+  /* Allocators are exchanged only if they propagate on swap, otherwise
+   * they must compare equal (as for std::vector) */
+  void swap(Vector &other) noexcept(kNothrowSteal) {
+    std::swap(static_cast<GrowthPolicy &>(*this),
+              static_cast<GrowthPolicy &>(other));
+    allocator_holder::SwapAllocator(other);
+    SwapStorage(other);
   }
 
+  /* Growth policy state, e.g. counters of growth::Counted */
+  const GrowthPolicy &growth_policy() const noexcept { return *this; }
+
+  allocator_type get_allocator() const { return GetAllocator(); }
+
  private:
   /*  PRIVATE ATTRIBUTES */
+  /* vArr points to raw storage for vCapacity elements,
+   * only [0, vSize) of it holds constructed objects */
   size_type vSize;
   size_type vCapacity;
   T *vArr;
 
   /* SUPPORT METHODS */
-  void CopyEntryVector(const Vector<T> &entry_vector) {
-    for (size_t i = 0; i < entry_vector.vSize; ++i) at(i) = entry_vector.at(i);
+  /* Repeats one value count times, lets fill insert share the range path */
+  class FillIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    FillIterator(const T *value, size_type index)
+        : value_(value), index_(index) {}
+
+    reference operator*() const { return *value_; }
+    FillIterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    FillIterator operator++(int) {
+      FillIterator copy(*this);
+      ++index_;
+      return copy;
+    }
+    bool operator==(const FillIterator &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const FillIterator &other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const T *value_;
+    size_type index_;
+  };
+
+  /* Inserts count elements of [first, last) before pos: in place the tail is
+   * shifted once, otherwise everything goes to a new buffer in one pass */
+  template <typename ForwardIt>
+  iterator InsertRange(const_iterator pos, ForwardIt first, ForwardIt last,
+                       size_type count) {
+    size_type index = 0;
+    if (vSize != 0) {
+      index = pos - begin();  // when vSize = 0, begin() can be ub
+    }
+    if (count == 0) return begin() + index;
+
+    if (vSize + count > vCapacity) {
+      size_type new_capacity = NextCapacity(vSize + count);
+      T *new_data = AllocateStorage(new_capacity);
+      try {
+        std::uninitialized_copy(first, last, new_data + index);
+      } catch (...) {
+        DeallocateStorage(new_data, new_capacity);
+        throw;
+      }
+      try {
+        RelocateRange(vArr, vArr + index, new_data);
+      } catch (...) {
+        DestroyRange(new_data + index, new_data + index + count);
+        DeallocateStorage(new_data, new_capacity);
+        throw;
+      }
+      try {
+        RelocateRange(vArr + index, vArr + vSize, new_data + index + count);
+      } catch (...) {
+        DestroyRange(new_data, new_data + index + count);
+        DeallocateStorage(new_data, new_capacity);
+        throw;
+      }
+      AdoptStorage(new_data, vSize + count, new_capacity);
+    } else if constexpr (kTriviallyCopyable) {
+      std::memmove(static_cast<void *>(vArr + index + count), vArr + index,
+                   (vSize - index) * sizeof(T));
+      std::uninitialized_copy(first, last, vArr + index);
+      vSize += count;
+    } else {
+      T *position = vArr + index;
+      T *old_end = vArr + vSize;
+      size_type elems_after = vSize - index;
+      if (elems_after > count) {
+        std::uninitialized_move(old_end - count, old_end, old_end);
+        vSize += count;
+        std::move_backward(position, old_end - count, old_end);
+        std::copy(first, last, position);
+      } else {
+        ForwardIt mid = std::next(first, elems_after);
+        std::uninitialized_copy(mid, last, old_end);
+        vSize += count - elems_after;
+        std::uninitialized_move(position, old_end, vArr + vSize);
+        vSize += elems_after;
+        std::copy(first, mid, position);
+      }
+    }
+    return begin() + index;
+  }
+
+  /* Destroys elements past new_size */
+  void EraseTail(size_type new_size) noexcept {
+    DestroyRange(vArr + new_size, vArr + vSize);
+    vSize = new_size;
+  }
+
+  /* Relocation, shifting and copying of such types is done in bulk with
+   * memcpy/memmove instead of per-element constructors */
+  static constexpr bool kTriviallyCopyable = std::is_trivially_copyable_v<T>;
+
+  /* Policies such as growth::InlineBuffer (SmallVector) provide the first
+   * kInlineCapacity slots inside the vector object itself */
+  static constexpr size_type kInlineCapacity =
+      growth::InlineCapacity<GrowthPolicy>::value;
+  static constexpr bool kNothrowSteal =
+      kInlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>;
+
+  T *InlineData() noexcept {
+    if constexpr (kInlineCapacity != 0) {
+      return GrowthPolicy::InlineData();
+    } else {
+      return nullptr;
+    }
+  }
+
+  bool UsesInlineStorage() noexcept {
+    return kInlineCapacity != 0 && vArr == InlineData();
+  }
+
+  /* Returns storage for at least capacity elements and stores the real
+   * capacity back: the inline buffer is handed out while it is free */
+  T *AllocateStorage(size_type &capacity) {
+    if (kInlineCapacity != 0 && capacity <= kInlineCapacity &&
+        !UsesInlineStorage()) {
+      capacity = kInlineCapacity;
+      return InlineData();
+    }
+    if (capacity == 0) return nullptr;
+    return allocator_traits::allocate(GetAllocator(), capacity);
+  }
+
+  void DeallocateStorage(T *ptr, size_type capacity) noexcept {
+    if (ptr == nullptr) return;
+    if (kInlineCapacity != 0 && ptr == InlineData()) return;
+    allocator_traits::deallocate(GetAllocator(), ptr, capacity);
+  }
+
+  static void DestroyRange(T *first, T *last) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (; first != last; ++first) first->~value_type();
+    }
+  }
+
+  /* Copies the object representation of [first, last) to dest.
+   * Only valid for trivially copyable T, ranges may not overlap */
+  static void CopyBytes(const T *first, const T *last, T *dest) noexcept {
+    if (first != last) {
+      std::memcpy(static_cast<void *>(dest), first,
+                  static_cast<size_type>(last - first) * sizeof(T));
+    }
+  }
+
+  /* Constructs [first, last) into dest by move when it can not throw,
+   * by copy otherwise (strong guarantee as std::vector does) */
+  static void RelocateRange(T *first, T *last, T *dest) {
+    if constexpr (kTriviallyCopyable) {
+      CopyBytes(first, last, dest);
+    } else if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                         !std::is_copy_constructible_v<T>) {
+      std::uninitialized_move(first, last, dest);
+    } else {
+      std::uninitialized_copy(first, last, dest);
+    }
+  }
+
+  /* Moves live [first, last) down to dest (dest < first) */
+  static void MoveLeft(T *first, T *last, T *dest) {
+    if constexpr (kTriviallyCopyable) {
+      if (first != last) {
+        std::memmove(static_cast<void *>(dest), first,
+                     static_cast<size_type>(last - first) * sizeof(T));
+      }
+    } else {
+      std::move(first, last, dest);
+    }
+  }
+
+  void Reallocate(size_type new_capacity) {
+    T *new_data = AllocateStorage(new_capacity);
+    try {
+      RelocateRange(vArr, vArr + vSize, new_data);
+    } catch (...) {
+      DeallocateStorage(new_data, new_capacity);
+      throw;
+    }
+    AdoptStorage(new_data, vSize, new_capacity);
+  }
+
+  /* Empty storage of a new or moved-from vector */
+  void ResetStorage() noexcept {
+    vArr = InlineData();
+    vCapacity = kInlineCapacity;
+    vSize = 0U;
+  }
+
+  /* Allocates storage of a just constructed vector */
+  void InitStorage(size_type capacity) {
+    if (capacity > vCapacity) {
+      vArr = AllocateStorage(capacity);
+      vCapacity = capacity;
+    }
+  }
+
+  /* Takes the elements of other, *this must hold no elements and own no heap
+   * buffer. Inline elements can not change hands and are relocated. */
+  void StealStorage(Vector &other) noexcept(kNothrowSteal) {
+    if (other.UsesInlineStorage()) {
+      RelocateRange(other.vArr, other.vArr + other.vSize, vArr);
+      vSize = other.vSize;
+      other.clear();
+      return;
+    }
+    vArr = other.vArr;
+    vSize = other.vSize;
+    vCapacity = other.vCapacity;
+    other.ResetStorage();
+  }
+
+  void SwapStorage(Vector &other) noexcept(kNothrowSteal) {
+    if (UsesInlineStorage() || other.UsesInlineStorage()) {
+      Vector tmp(GetAllocator());
+      tmp.StealStorage(other);
+      other.StealStorage(*this);
+      StealStorage(tmp);
+      return;
+    }
+    std::swap(vArr, other.vArr);
+    std::swap(vSize, other.vSize);
+    std::swap(vCapacity, other.vCapacity);
+  }
+
+  /* Releases the current buffer and takes over an already filled one */
+  void AdoptStorage(T *new_data, size_type new_size,
+                    size_type new_capacity) noexcept {
+    GrowthPolicy::OnReallocate(vSize * sizeof(T));
+    CleanArr();
+    vArr = new_data;
+    vSize = new_size;
+    vCapacity = new_capacity;
+  }
+
+  /* Capacity to grow to when required elements do not fit */
+  size_type NextCapacity(size_type required) const {
+    if (required > max_size()) throw std::length_error("Vector: too long");
+    size_type next = GrowthPolicy::Grow(vCapacity, required, sizeof(T));
+    return std::min(std::max(next, required), max_size());
   }
 
-  void CleanArr() { delete[] vArr; }
+  /* Fills raw storage of a freshly allocated vector */
+  void CopyEntryVector(const Vector &entry_vector) {
+    if constexpr (kTriviallyCopyable) {
+      CopyBytes(entry_vector.vArr, entry_vector.vArr + entry_vector.vSize,
+                vArr);
+    } else {
+      std::uninitialized_copy(entry_vector.vArr,
+                              entry_vector.vArr + entry_vector.vSize, vArr);
+    }
+    vSize = entry_vector.vSize;
+  }
+
+  /* Destroys live elements and releases storage */
+  void CleanArr() noexcept {
+    DestroyRange(vArr, vArr + vSize);
+    DeallocateStorage(vArr, vCapacity);
+    vSize = 0;
+  }
 };
 
 }  // namespace s21
 
-#endif  // CPP2_S21_CONTAINERS_1_MASTER_VECTOR_H
\ No newline at end of file
+#endif  // CPP2_S21_CONTAINERS_1_MASTER_VECTOR_H
@@ -1,438 +1,1235 @@
 #ifndef CPPCONTAINERS_TREE_H
 #define CPPCONTAINERS_TREE_H
 
-#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
-#include "../s21_vector.h"
+#include "../s21_allocator.h"
+#include "../s21_keys.h"
 
 namespace s21 {
 
-template <typename T>
-class tree {
+/* Links and colour of a tree node. The end() node of a tree is a bare
+ * TreeNodeBase embedded in the tree object: its parent_ is the root, its
+ * left_node_ the largest and its right_node_ the smallest element. */
+struct TreeNodeBase {
+  TreeNodeBase *parent_;
+  TreeNodeBase *left_node_;
+  TreeNodeBase *right_node_;
+  bool is_empty = false;
+  bool is_red = true;
+
+  static TreeNodeBase *Next(TreeNodeBase *curr_node) noexcept {
+    if (curr_node->is_empty) {
+      return curr_node->right_node_;
+    }
+    if (curr_node->right_node_) {
+      curr_node = curr_node->right_node_;
+      while (curr_node->left_node_) {
+        curr_node = curr_node->left_node_;
+      }
+    } else {
+      TreeNodeBase *buff = curr_node;
+      curr_node = curr_node->parent_;
+      while (buff == curr_node->right_node_ && !curr_node->is_empty) {
+        buff = curr_node;
+        curr_node = curr_node->parent_;
+      }
+    }
+    return curr_node;
+  }
+
+  static TreeNodeBase *Prev(TreeNodeBase *curr_node) noexcept {
+    if (curr_node->is_empty) {
+      return curr_node->left_node_;
+    }
+    if (curr_node->left_node_) {
+      curr_node = curr_node->left_node_;
+      while (curr_node->right_node_) {
+        curr_node = curr_node->right_node_;
+      }
+    } else {
+      TreeNodeBase *buff = curr_node;
+      curr_node = curr_node->parent_;
+      while (buff == curr_node->left_node_ && !curr_node->is_empty) {
+        buff = curr_node;
+        curr_node = curr_node->parent_;
+      }
+    }
+    return curr_node;
+  }
+};
+
+/* Number of elements in the subtree of a node, kept only by ranked trees.
+ * The unranked version is an empty base and costs no memory */
+template <bool Ranked>
+struct TreeNodeSize {};
+
+template <>
+struct TreeNodeSize<true> {
+  std::size_t subtree_size = 1;
+};
+
+template <typename T, bool Ranked = false>
+struct TreeNode : TreeNodeBase, TreeNodeSize<Ranked> {
+  template <typename... Args>
+  explicit TreeNode(Args &&...args)
+      : TreeNodeBase{nullptr, nullptr, nullptr},
+        value_(std::forward<Args>(args)...) {}
+
+  T value_;
+};
+
+/* Iterators depend on the node type only, so set<int> and multiset<int>
+ * share them */
+template <typename T, bool Ranked = false>
+class TreeIterator {
  public:
-  class Iterator;
-  class IteratorConst;
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
+  TreeNodeBase *curr_node = nullptr;
+
+  TreeIterator() = default;
+  explicit TreeIterator(TreeNodeBase *node) : curr_node(node) {}
+
+  reference operator*() const noexcept {
+    return static_cast<TreeNode<T, Ranked> *>(curr_node)->value_;
+  }
+  pointer operator->() const noexcept { return &**this; }
 
-  using key_type = T;
+  friend bool operator==(const TreeIterator &a,
+                         const TreeIterator &b) noexcept {
+    return a.curr_node == b.curr_node;
+  }
+  friend bool operator!=(const TreeIterator &a,
+                         const TreeIterator &b) noexcept {
+    return a.curr_node != b.curr_node;
+  }
+
+  TreeIterator &operator++() noexcept {
+    curr_node = TreeNodeBase::Next(curr_node);
+    return *this;
+  }
+  TreeIterator operator++(int) noexcept {
+    TreeIterator n = *this;
+    ++*this;
+    return n;
+  }
+  TreeIterator &operator--() noexcept {
+    curr_node = TreeNodeBase::Prev(curr_node);
+    return *this;
+  }
+  TreeIterator operator--(int) noexcept {
+    TreeIterator n = *this;
+    --*this;
+    return n;
+  }
+};
+
+template <typename T, bool Ranked = false>
+class TreeConstIterator {
+ public:
+  using iterator_category = std::bidirectional_iterator_tag;
   using value_type = T;
-  using cosnt_value_type = const T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const T *;
+  using reference = const T &;
+
+  TreeNodeBase *curr_node = nullptr;
+
+  TreeConstIterator() = default;
+  TreeConstIterator(const TreeIterator<T, Ranked> &it)
+      : curr_node(it.curr_node) {}
+  explicit TreeConstIterator(const TreeNodeBase *node)
+      : curr_node(const_cast<TreeNodeBase *>(node)) {}
+
+  reference operator*() const noexcept {
+    return static_cast<const TreeNode<T, Ranked> *>(curr_node)->value_;
+  }
+  pointer operator->() const noexcept { return &**this; }
+
+  friend bool operator==(const TreeConstIterator &a,
+                         const TreeConstIterator &b) noexcept {
+    return a.curr_node == b.curr_node;
+  }
+  friend bool operator!=(const TreeConstIterator &a,
+                         const TreeConstIterator &b) noexcept {
+    return a.curr_node != b.curr_node;
+  }
+
+  TreeConstIterator &operator++() noexcept {
+    curr_node = TreeNodeBase::Next(curr_node);
+    return *this;
+  }
+  TreeConstIterator operator++(int) noexcept {
+    TreeConstIterator n = *this;
+    ++*this;
+    return n;
+  }
+  TreeConstIterator &operator--() noexcept {
+    curr_node = TreeNodeBase::Prev(curr_node);
+    return *this;
+  }
+  TreeConstIterator operator--(int) noexcept {
+    TreeConstIterator n = *this;
+    --*this;
+    return n;
+  }
+};
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, typename Allocator, bool Ranked = false>
+class tree;
+
+/* Owns a node extracted from a tree until it is inserted into another
+ * tree with an equal allocator, so an element changes containers without
+ * being copied or reallocated. Destroys the node if it is never inserted */
+template <typename Value, typename Allocator, bool Ranked = false>
+class TreeNodeHandle {
+  using node = TreeNode<Value, Ranked>;
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+ public:
+  using value_type = Value;
+  using allocator_type = Allocator;
+
+  TreeNodeHandle() noexcept = default;
+  TreeNodeHandle(TreeNodeHandle &&other) noexcept
+      : node_(other.node_), alloc_(std::move(other.alloc_)) {
+    other.node_ = nullptr;
+    other.alloc_.reset();
+  }
+  TreeNodeHandle &operator=(TreeNodeHandle &&other) noexcept {
+    if (this != &other) {
+      reset();
+      node_ = other.node_;
+      alloc_ = std::move(other.alloc_);
+      other.node_ = nullptr;
+      other.alloc_.reset();
+    }
+    return *this;
+  }
+  ~TreeNodeHandle() { reset(); }
+
+  [[nodiscard]] bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+  allocator_type get_allocator() const { return allocator_type(*alloc_); }
+
+  /* Element of a set node */
+  value_type &value() const noexcept { return node_->value_; }
+
+  /* Key and mapped value of a map node, the key may be changed before the
+   * node is inserted again */
+  template <typename V = Value>
+  auto &key() const noexcept {
+    using key_type = std::remove_const_t<typename V::first_type>;
+    return const_cast<key_type &>(node_->value_.first);
+  }
+  template <typename V = Value>
+  typename V::second_type &mapped() const noexcept {
+    return node_->value_.second;
+  }
+
+ private:
+  template <typename, typename, typename, typename, bool, typename, bool>
+  friend class tree;
+
+  TreeNodeHandle(node *item, const node_allocator &alloc)
+      : node_(item), alloc_(alloc) {}
+
+  node *release() noexcept {
+    node *item = node_;
+    node_ = nullptr;
+    alloc_.reset();
+    return item;
+  }
+
+  void reset() noexcept {
+    if (node_) {
+      node_->~node();
+      node_traits::deallocate(*alloc_, node_, 1);
+      node_ = nullptr;
+    }
+    alloc_.reset();
+  }
+
+  node *node_ = nullptr;
+  std::optional<node_allocator> alloc_;
+};
+
+/* Ordered red-black tree shared by map, multimap, set and multiset.
+ * Value is what a node stores, KeyOfValue extracts its Key, Compare orders
+ * the keys and Unique rejects equal keys. Nodes are allocated with
+ * Allocator rebound to TreeNode<Value, Ranked>. A Ranked tree keeps subtree
+ * sizes in its nodes, which gives nth(), rank() and distance() in
+ * O(log n) for one extra word per node. */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          bool Unique, typename Allocator, bool Ranked>
+class tree : private AllocatorHolder<typename std::allocator_traits<
+                 Allocator>::template rebind_alloc<TreeNode<Value, Ranked>>> {
+ public:
+  using Iterator = TreeIterator<Value, Ranked>;
+  using IteratorConst = TreeConstIterator<Value, Ranked>;
+
+  using key_type = Key;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
   using iterator = Iterator;
   using const_iterator = IteratorConst;
-  using size_type = size_t;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
- public:
-  struct Node {
-    Node *parent_;
-    Node *left_node_;
-    Node *right_node_;
-    value_type value_;
-    bool is_empty = false;
-
-    explicit Node()
-        : parent_(nullptr),
-          left_node_(nullptr),
-          right_node_(nullptr),
-          value_(value_type{}) {}
-    explicit Node(const value_type &value)
-        : parent_(nullptr),
-          left_node_(nullptr),
-          right_node_(nullptr),
-          value_(value) {}
+  using Node = TreeNode<Value, Ranked>;
+  using NodeBase = TreeNodeBase;
+
+  static constexpr bool is_ranked = Ranked;
+
+  using node_type = TreeNodeHandle<Value, Allocator, Ranked>;
+
+  /* Result of inserting a node handle: node is empty unless a unique tree
+   * already held the key, then it still owns the rejected node */
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
   };
 
-  class Iterator {
-   public:
-    using iterator_category = std::bidirectional_iterator_tag;
+ private:
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using allocator_holder = AllocatorHolder<node_allocator>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using allocator_holder::GetAllocator;
 
-   public:
-    Node *curr_node;
+  template <typename, typename, typename, typename, bool, typename, bool>
+  friend class tree;
 
-    Iterator() = delete;
+  NodeBase end_node;
+  size_type tree_size;
+  Compare compare_;
 
-    explicit Iterator(Node *node) : curr_node(node) {}
+ public:
+  tree() : tree(Compare(), allocator_type()) {}
 
-    value_type &operator*() noexcept { return curr_node->value_; }
+  explicit tree(const allocator_type &alloc) : tree(Compare(), alloc) {}
 
-    bool operator==(const Iterator &other) const noexcept {
-      return curr_node == other.curr_node;
-    }
+  explicit tree(const Compare &comp,
+                const allocator_type &alloc = allocator_type())
+      : allocator_holder(node_allocator(alloc)),
+        end_node{nullptr, nullptr, nullptr},
+        tree_size(0),
+        compare_(comp) {
+    root_is_empty();
+  }
+
+  tree(const tree &other)
+      : tree(other.compare_,
+             allocator_type(node_traits::select_on_container_copy_construction(
+                 other.GetAllocator()))) {
+    copy_tree(other);
+  }
+
+  tree(tree &&other) noexcept
+      : allocator_holder(std::move(other.GetAllocator())),
+        end_node{nullptr, nullptr, nullptr},
+        tree_size(0),
+        compare_(other.compare_) {
+    root_is_empty();
+    take_nodes(other);
+  }
 
-    bool operator!=(const Iterator &other) const noexcept {
-      return curr_node != other.curr_node;
+  ~tree() { destroy_node(root()); }
+
+  tree &operator=(const tree &other) {
+    if (this != &other) {
+      clear();
+      this->CopyAssignAllocator(other);
+      compare_ = other.compare_;
+      copy_tree(other);
     }
+    return *this;
+  }
 
-    Iterator &operator++() noexcept {
-      IteratorPlus();
-      return *this;
+  tree &operator=(tree &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    clear();
+    compare_ = other.compare_;
+    if (node_traits::propagate_on_container_move_assignment::value ||
+        this->SameAllocator(other)) {
+      this->MoveAssignAllocator(other);
+      take_nodes(other);
+    } else {
+      // nodes of other can not be released by our allocator
+      for (iterator it = other.begin(); it != other.end(); ++it) {
+        emplace_hint(end(), std::move(*it));
+      }
+      other.clear();
     }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(GetAllocator());
+  }
+  key_compare key_comp() const { return compare_; }
+
+  [[nodiscard]] iterator begin() noexcept {
+    return Iterator(end_node.right_node_);
+  }
+  [[nodiscard]] iterator end() noexcept { return Iterator(&end_node); }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return IteratorConst(end_node.right_node_);
+  }
+  [[nodiscard]] const_iterator end() const noexcept {
+    return IteratorConst(&end_node);
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return tree_size == 0; }
+  [[nodiscard]] size_type size() const noexcept { return tree_size; }
+  [[nodiscard]] size_type max_size() const noexcept {
+    return node_traits::max_size(GetAllocator());
+  };
+
+  void clear() noexcept {
+    destroy_node(root());
+    root_is_empty();
+  }
+
+  /* For a unique tree the bool is false and the iterator points to the
+   * element that blocked the insertion; a multi tree always inserts, after
+   * the elements with an equal key */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return insert_value(value);
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return insert_value(std::move(value));
+  }
 
-    Iterator operator++(int) noexcept {
-      iterator *n = this;
-      IteratorPlus();
-      return *n;
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Node *new_node = create_node(std::forward<Args>(args)...);
+    InsertPosition pos = find_insert_position(key_of(new_node));
+    if (pos.existing) {
+      destroy(new_node);
+      return std::make_pair(Iterator(pos.existing), false);
     }
+    return std::make_pair(link_node(new_node, pos), true);
+  }
 
-    Iterator &operator--() noexcept {
-      IteratorMinus();
-      return *this;
+  /* Inserts close to hint when the key belongs right before it, which makes
+   * building from sorted input linear */
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    Node *new_node = create_node(std::forward<Args>(args)...);
+    InsertPosition pos = find_hint_position(hint.curr_node, key_of(new_node));
+    if (pos.existing) {
+      destroy(new_node);
+      return Iterator(pos.existing);
     }
+    return link_node(new_node, pos);
+  }
+
+  iterator erase(const_iterator pos) noexcept {
+    NodeBase *curr_pos = pos.curr_node;
+    iterator next(NodeBase::Next(curr_pos));
+    unlink_node(curr_pos);
+    destroy(static_cast<Node *>(curr_pos));
+    return next;
+  }
 
-    Iterator operator--(int) noexcept {
-      iterator *n = this;
-      IteratorMinus();
-      return *n;
+  size_type erase(const key_type &key) {
+    std::pair<iterator, iterator> range = equal_range(key);
+    size_type count = 0;
+    while (range.first != range.second) {
+      range.first = erase(range.first);
+      ++count;
     }
+    return count;
+  }
 
-   private:
-    void IteratorPlus() {
-      if (curr_node->right_node_) {
-        curr_node = curr_node->right_node_;
-        while (curr_node->left_node_) {
-          curr_node = curr_node->left_node_;
+  /* Replaces the contents with [first, last), which must be sorted by
+   * Compare. The tree is built in O(n) without searching; a unique tree
+   * keeps the first of equal neighbours and compares each element with the
+   * previous one only to find them */
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last) {
+    clear();
+    NodeBase *tail = &end_node;
+    size_type count = 0;
+    try {
+      for (; first != last; ++first) {
+        if (Unique && tail != &end_node &&
+            !compare_(key_of(tail), KeyOfValue()(*first))) {
+          continue;
         }
-      } else {
-        Node *buff = curr_node;
-        curr_node = curr_node->parent_;
-        while (buff == curr_node->right_node_ && !curr_node->is_empty) {
-          buff = curr_node;
-          curr_node = curr_node->parent_;
+        Node *new_node = create_node(*first);
+        new_node->is_red = false;
+        new_node->parent_ = tail;
+        if (tail == &end_node) {
+          end_node.parent_ = new_node;
+        } else {
+          tail->right_node_ = new_node;
         }
+        tail = new_node;
+        ++count;
       }
+    } catch (...) {
+      clear();
+      throw;
     }
-    void IteratorMinus() {
-      if (curr_node->left_node_) {
-        curr_node = curr_node->left_node_;
-        while (curr_node->right_node_) {
-          curr_node = curr_node->right_node_;
-        }
-      } else {
-        Node *buff = curr_node;
-        curr_node = curr_node->parent_;
-        while (buff == curr_node->left_node_) {
-          buff = curr_node;
-          curr_node = curr_node->parent_;
-        }
+    if (count == 0) return;
+    end_node.right_node_ = root();
+    end_node.left_node_ = tail;
+    tree_size = count;
+    if constexpr (Ranked) {
+      size_type size = 0;
+      for (NodeBase *item = tail; item != &end_node; item = item->parent_) {
+        as_node(item)->subtree_size = ++size;
       }
     }
-  };
+    chain_to_tree();
+  }
 
-  class IteratorConst {
-   public:
-    using iterator_category = std::bidirectional_iterator_tag;
+  void swap(tree &other) noexcept {
+    if (this == &other) return;
+    this->SwapAllocator(other);
+    std::swap(compare_, other.compare_);
+    tree tmp(compare_, get_allocator());
+    tmp.take_nodes(other);
+    other.take_nodes(*this);
+    take_nodes(tmp);
+  }
 
-   public:
-    Node *curr_node;
+  /* Unlinks the element at pos and hands its node over to the caller */
+  node_type extract(const_iterator pos) noexcept {
+    unlink_node(pos.curr_node);
+    return node_type(as_node(pos.curr_node), GetAllocator());
+  }
 
-    IteratorConst() = delete;
-    IteratorConst(Iterator &it) : curr_node(it.curr_node) {}
-    IteratorConst(Iterator &&it) : curr_node(it.curr_node) {}
-    explicit IteratorConst(Node *node) : curr_node(node) {}
-    cosnt_value_type &operator*() noexcept { return curr_node->value_; }
+  node_type extract(const key_type &key) {
+    const_iterator pos = find(key);
+    return pos == end() ? node_type() : extract(pos);
+  }
 
-    bool operator==(const Iterator &other) const noexcept {
-      return curr_node == other.curr_node;
+  /* Links the node owned by handle into the tree. A node from a tree with
+   * an unequal allocator can not be adopted, its value is moved into a new
+   * node instead */
+  insert_return_type insert(node_type &&handle) {
+    if (handle.empty()) return insert_return_type{end(), false, node_type()};
+    InsertPosition pos = find_insert_position(key_of(handle.node_));
+    if (pos.existing) {
+      return insert_return_type{Iterator(pos.existing), false,
+                                std::move(handle)};
     }
-
-    bool operator!=(const Iterator &other) const noexcept {
-      return curr_node != other.curr_node;
+    if (!(*handle.alloc_ == GetAllocator())) {
+      iterator position = emplace_at(pos, std::move(handle.value())).first;
+      handle.reset();
+      return insert_return_type{position, true, node_type()};
     }
+    return insert_return_type{link_node(handle.release(), pos), true,
+                              node_type()};
+  }
 
-    IteratorConst &operator++() noexcept {
-      IteratorPlus();
-      return *this;
+  /* Moves the elements of other that this tree accepts by relinking their
+   * nodes, so nothing is allocated or copied; a unique tree leaves the
+   * duplicates in other. With unequal allocators values are moved into
+   * new nodes instead */
+  template <typename OtherCompare, bool OtherUnique>
+  void merge(tree<Key, Value, KeyOfValue, OtherCompare, OtherUnique,
+                  Allocator, Ranked> &other) {
+    if (static_cast<void *>(this) == static_cast<void *>(&other)) return;
+    const bool relink = GetAllocator() == other.GetAllocator();
+    for (NodeBase *item = other.end_node.right_node_;
+         item != &other.end_node;) {
+      NodeBase *next = NodeBase::Next(item);
+      InsertPosition pos = find_insert_position(key_of(item));
+      if (!pos.existing) {
+        if (relink) {
+          other.unlink_node(item);
+          link_node(as_node(item), pos);
+        } else {
+          emplace_at(pos, std::move(as_node(item)->value_));
+          other.erase(IteratorConst(item));
+        }
+      }
+      item = next;
     }
+  }
 
-    IteratorConst operator++(int) noexcept {
-      iterator *n = this;
-      IteratorPlus();
-      return *n;
-    }
+  iterator find(const key_type &key) { return Iterator(find_node(key)); }
+  const_iterator find(const key_type &key) const {
+    return IteratorConst(find_node(key));
+  }
 
-    IteratorConst &operator--() noexcept {
-      IteratorMinus();
-      return *this;
-    }
+  [[nodiscard]] bool contains(const key_type &key) const {
+    return find_node(key) != &end_node;
+  }
 
-    IteratorConst operator--(int) noexcept {
-      iterator *n = this;
-      IteratorMinus();
-      return *n;
-    };
+  size_type count(const key_type &key) const { return count_keys(key); }
 
-   private:
-    void IteratorPlus() {
-      if (curr_node->right_node_) {
-        curr_node = curr_node->right_node_;
-        while (curr_node->left_node_) {
-          curr_node = curr_node->left_node_;
-        }
-      } else {
-        Node *buff = curr_node;
-        curr_node = curr_node->parent_;
-        while (buff == curr_node->right_node_ && !curr_node->is_empty) {
-          buff = curr_node;
-          curr_node = curr_node->parent_;
-        }
-      }
-    }
-    void IteratorMinus() {
-      if (curr_node->left_node_) {
-        curr_node = curr_node->left_node_;
-        while (curr_node->right_node_) {
-          curr_node = curr_node->right_node_;
-        }
-      } else {
-        Node *buff = curr_node;
-        curr_node = curr_node->parent_;
-        while (buff == curr_node->left_node_) {
-          buff = curr_node;
-          curr_node = curr_node->parent_;
-        }
-      }
-    }
-  };
+  /* First element whose key is not less than key */
+  iterator lower_bound(const key_type &key) {
+    return Iterator(lower_bound_node(key));
+  }
+  const_iterator lower_bound(const key_type &key) const {
+    return IteratorConst(lower_bound_node(key));
+  }
 
- private:
-  Node *root_node;
-  Node *node;
-  size_type tree_size;
+  /* First element whose key is greater than key */
+  iterator upper_bound(const key_type &key) {
+    return Iterator(upper_bound_node(key));
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return IteratorConst(upper_bound_node(key));
+  }
 
- public:
-  tree() : node(new Node()), tree_size(0) { root_is_empty(); }
+  std::pair<iterator, iterator> equal_range(const key_type &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
 
-  tree(const tree &other) : tree() { copy_tree(other.root_node); }
+  /* Order statistics, ranked trees only */
 
-  tree(tree &&other) noexcept
-      : root_node(other.root_node),
-        node(other.node),
-        tree_size(other.tree_size) {
-    other.root_node = nullptr;
-    other.node = nullptr;
-    other.tree_size = 0;
+  /* Element at position k in sorted order or end() if k >= size() */
+  iterator nth(size_type k) { return Iterator(nth_node(k)); }
+  const_iterator nth(size_type k) const { return IteratorConst(nth_node(k)); }
+
+  /* Number of elements whose key is less than key */
+  size_type rank(const key_type &key) const {
+    return index_of(lower_bound_node(key));
   }
 
-  ~tree() {
-    if (root_node != node) destroy_node(root_node);
-    delete node;
+  /* Position of pos in sorted order, size() for end() */
+  size_type index(const_iterator pos) const { return index_of(pos.curr_node); }
+
+  /* std::distance(first, last) without walking the range */
+  size_type distance(const_iterator first, const_iterator last) const {
+    return index_of(last.curr_node) - index_of(first.curr_node);
   }
 
-  tree &operator=(tree &&other) noexcept {
-    root_node = other.root_node;
-    node = other.node;
-    tree_size = other.tree_size;
+  /* Heterogeneous lookup, available when Compare is transparent (for
+   * example std::less<>): a std::string key can be found by a
+   * std::string_view without building a temporary key */
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return Iterator(find_node(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K &key) const {
+    return IteratorConst(find_node(key));
+  }
 
-    other.root_node = nullptr;
-    other.node = nullptr;
-    other.tree_size = 0;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  [[nodiscard]] bool contains(const K &key) const {
+    return find_node(key) != &end_node;
+  }
 
-    return *this;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) const {
+    return count_keys(key);
   }
 
-  [[nodiscard]] iterator begin() noexcept {
-    return Iterator(node->right_node_);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return Iterator(lower_bound_node(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator lower_bound(const K &key) const {
+    return IteratorConst(lower_bound_node(key));
   }
-  [[nodiscard]] iterator end() noexcept { return Iterator(node); }
 
-  [[nodiscard]] const_iterator begin() const noexcept {
-    return IteratorConst(node->right_node_);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return Iterator(upper_bound_node(key));
   }
-  [[nodiscard]] const_iterator end() const noexcept {
-    return IteratorConst(node);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator upper_bound(const K &key) const {
+    return IteratorConst(upper_bound_node(key));
   }
 
-  [[nodiscard]] bool empty() const noexcept { return root_node == node; }
-  [[nodiscard]] size_type size() const noexcept { return tree_size; }
-  [[nodiscard]] size_type max_size() const noexcept {
-    return std::numeric_limits<size_type>::max() / sizeof(Node) / 2;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::make_pair(Iterator(lower_bound_node(key)),
+                          Iterator(upper_bound_node(key)));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const {
+    return std::make_pair(IteratorConst(lower_bound_node(key)),
+                          IteratorConst(upper_bound_node(key)));
+  }
+
+ protected:
+  /* Where a new key goes: under parent on the left or right side, or the
+   * node that already holds the key in a unique tree */
+  struct InsertPosition {
+    NodeBase *parent;
+    bool left;
+    NodeBase *existing;
   };
 
-  void clear() {
-    if (!empty()) {
-      destroy_node(root_node);
-      root_is_empty();
+  static const key_type &key_of(const NodeBase *item) noexcept {
+    return KeyOfValue()(static_cast<const Node *>(item)->value_);
+  }
+
+  NodeBase *root() const noexcept { return end_node.parent_; }
+  Node *return_root() const noexcept { return static_cast<Node *>(root()); }
+
+  template <typename V>
+  std::pair<iterator, bool> insert_value(V &&value) {
+    return emplace_at(find_insert_position(KeyOfValue()(value)),
+                      std::forward<V>(value));
+  }
+
+  /* Builds the value only when pos is free, so a lookup that finds the key
+   * neither allocates nor constructs anything */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_at(const InsertPosition &pos,
+                                       Args &&...args) {
+    if (pos.existing) {
+      return std::make_pair(Iterator(pos.existing), false);
+    }
+    Node *new_node = create_node(std::forward<Args>(args)...);
+    return std::make_pair(link_node(new_node, pos), true);
+  }
+
+  /* One comparison per level: equal keys go right, so a multi tree keeps
+   * insertion order among them and a unique tree only has to compare the
+   * key with the in-order predecessor of the leaf position */
+  InsertPosition find_insert_position(const key_type &key) const {
+    NodeBase *parent = const_cast<NodeBase *>(&end_node);
+    NodeBase *current = root();
+    bool left = true;
+    while (current) {
+      parent = current;
+      left = compare_(key, key_of(current));
+      current = left ? current->left_node_ : current->right_node_;
+    }
+    InsertPosition pos{parent, left, nullptr};
+    if (Unique) {
+      NodeBase *prev = parent;
+      if (left) {
+        prev = parent == end_node.right_node_ ? nullptr
+                                               : NodeBase::Prev(parent);
+      }
+      if (prev && !compare_(key_of(prev), key)) pos.existing = prev;
     }
+    return pos;
   }
 
-  virtual std::pair<iterator, bool> insert(const value_type &value) {
-    return auto_insert(value, true);
+  /* Uses hint when key fits between its predecessor and hint, otherwise
+   * falls back to a full descent */
+  InsertPosition find_hint_position(NodeBase *hint, const key_type &key) {
+    bool fits_before_hint =
+        hint->is_empty || (Unique ? compare_(key, key_of(hint))
+                                  : !compare_(key_of(hint), key));
+    if (fits_before_hint) {
+      NodeBase *prev = hint == end_node.right_node_ ? nullptr
+                                                     : NodeBase::Prev(hint);
+      if (!prev || compare_(key_of(prev), key) ||
+          (!Unique && !compare_(key, key_of(prev)))) {
+        if (!prev) return InsertPosition{hint, true, nullptr};
+        if (!prev->right_node_) return InsertPosition{prev, false, nullptr};
+        return InsertPosition{hint, true, nullptr};
+      }
+    }
+    return find_insert_position(key);
   }
 
-  void erase(iterator pos) noexcept {
-    Node *curr_pos = pos.curr_node;
-    if (curr_pos == node->left_node_) {
-      iterator buff = pos;
-      --buff;
-      node->left_node_ = buff.curr_node;
-    } else if (curr_pos == node->right_node_) {
-      iterator buff = pos;
-      ++buff;
-      node->right_node_ = buff.curr_node;
+  iterator link_node(Node *new_node, const InsertPosition &pos) noexcept {
+    NodeBase *parent = pos.parent;
+    new_node->parent_ = parent;
+    new_node->left_node_ = nullptr;
+    new_node->right_node_ = nullptr;
+    new_node->is_red = true;
+    if (parent == &end_node) {
+      end_node.parent_ = new_node;
+      end_node.left_node_ = new_node;
+      end_node.right_node_ = new_node;
+    } else if (pos.left) {
+      parent->left_node_ = new_node;
+      if (parent == end_node.right_node_) end_node.right_node_ = new_node;
+    } else {
+      parent->right_node_ = new_node;
+      if (parent == end_node.left_node_) end_node.left_node_ = new_node;
     }
-    if (!curr_pos->left_node_ && !curr_pos->right_node_) {
-      if (curr_pos->parent_ == node) {
-        root_is_empty();
-      } else if (curr_pos == curr_pos->parent_->left_node_) {
-        curr_pos->parent_->left_node_ = nullptr;
-      } else {
-        curr_pos->parent_->right_node_ = nullptr;
+    if constexpr (Ranked) {
+      new_node->subtree_size = 1;
+      resize_path(parent, 1);
+    }
+    insert_fixup(new_node);
+    ++tree_size;
+    return Iterator(new_node);
+  }
+
+  /* Removes item from the tree without freeing it. Nodes are relinked
+   * rather than values swapped, so iterators to other elements stay valid */
+  void unlink_node(NodeBase *curr_pos) noexcept {
+    if (curr_pos == end_node.right_node_) {
+      end_node.right_node_ = NodeBase::Next(curr_pos);
+    }
+    if (curr_pos == end_node.left_node_) {
+      end_node.left_node_ = NodeBase::Prev(curr_pos);
+    }
+
+    NodeBase *removed = curr_pos;
+    bool removed_red = removed->is_red;
+    NodeBase *child;
+    NodeBase *child_parent;
+    if constexpr (Ranked) {
+      // every subtree that loses a node lies on the path up from the parent
+      // of the node that physically leaves its place
+      NodeBase *leaving = curr_pos;
+      if (curr_pos->left_node_ && curr_pos->right_node_) {
+        leaving = curr_pos->right_node_;
+        while (leaving->left_node_) leaving = leaving->left_node_;
       }
+      resize_path(leaving->parent_, -1);
+    }
+    if (!curr_pos->left_node_) {
+      child = curr_pos->right_node_;
+      child_parent = curr_pos->parent_;
+      transplant(curr_pos, child);
     } else if (!curr_pos->right_node_) {
-      if (curr_pos->parent_ == node) {
-        node->parent_ = curr_pos->left_node_;
-        curr_pos->left_node_->parent_ = node;
-        root_node = curr_pos->left_node_;
-      } else if (curr_pos == curr_pos->parent_->left_node_) {
-        curr_pos->parent_->left_node_ = curr_pos->left_node_;
-        curr_pos->left_node_->parent_ = curr_pos->parent_;
+      child = curr_pos->left_node_;
+      child_parent = curr_pos->parent_;
+      transplant(curr_pos, child);
+    } else {
+      removed = curr_pos->right_node_;
+      while (removed->left_node_) removed = removed->left_node_;
+      removed_red = removed->is_red;
+      child = removed->right_node_;
+      if (removed->parent_ == curr_pos) {
+        child_parent = removed;
       } else {
-        curr_pos->parent_->right_node_ = curr_pos->left_node_;
-        curr_pos->left_node_->parent_ = curr_pos->parent_;
+        child_parent = removed->parent_;
+        transplant(removed, child);
+        removed->right_node_ = curr_pos->right_node_;
+        removed->right_node_->parent_ = removed;
       }
-    } else if (!curr_pos->left_node_) {
-      if (curr_pos->parent_ == node) {
-        node->parent_ = curr_pos->right_node_;
-        curr_pos->right_node_->parent_ = node;
-        root_node = curr_pos->right_node_;
-      } else if (curr_pos == curr_pos->parent_->left_node_) {
-        curr_pos->parent_->left_node_ = curr_pos->right_node_;
-        curr_pos->right_node_->parent_ = curr_pos->parent_;
+      transplant(curr_pos, removed);
+      removed->left_node_ = curr_pos->left_node_;
+      removed->left_node_->parent_ = removed;
+      removed->is_red = curr_pos->is_red;
+      if constexpr (Ranked) {
+        as_node(removed)->subtree_size = as_node(curr_pos)->subtree_size;
+      }
+    }
+    if (!removed_red) erase_fixup(child, child_parent);
+
+    --tree_size;
+    if (tree_size == 0) root_is_empty();
+  }
 
+  template <typename K>
+  size_type count_keys(const K &key) const {
+    if (Unique) return find_node(key) != &end_node ? 1 : 0;
+    if constexpr (Ranked) {
+      return index_of(upper_bound_node(key)) - index_of(lower_bound_node(key));
+    }
+    size_type result = 0;
+    NodeBase *last = upper_bound_node(key);
+    for (NodeBase *item = lower_bound_node(key); item != last;
+         item = NodeBase::Next(item)) {
+      ++result;
+    }
+    return result;
+  }
+
+  /* The lookups below call compare_ once per level */
+  template <typename K>
+  NodeBase *find_node(const K &key) const {
+    NodeBase *found = lower_bound_node(key);
+    if (found != &end_node && compare_(key, key_of(found))) {
+      return const_cast<NodeBase *>(&end_node);
+    }
+    return found;
+  }
+
+  template <typename K>
+  NodeBase *lower_bound_node(const K &key) const {
+    NodeBase *result = const_cast<NodeBase *>(&end_node);
+    NodeBase *current = root();
+    while (current) {
+      if (compare_(key_of(current), key)) {
+        current = current->right_node_;
       } else {
-        curr_pos->parent_->right_node_ = curr_pos->right_node_;
-        curr_pos->right_node_->parent_ = curr_pos->parent_;
+        result = current;
+        current = current->left_node_;
       }
-    } else {
-      iterator buff = pos;
-      ++pos;
-      std::swap(buff.curr_node->value_, pos.curr_node->value_);
-      if (buff.curr_node->right_node_ == pos.curr_node) {
-        buff.curr_node->right_node_ = pos.curr_node->right_node_;
+    }
+    return result;
+  }
+
+  template <typename K>
+  NodeBase *upper_bound_node(const K &key) const {
+    NodeBase *result = const_cast<NodeBase *>(&end_node);
+    NodeBase *current = root();
+    while (current) {
+      if (compare_(key, key_of(current))) {
+        result = current;
+        current = current->left_node_;
       } else {
-        pos.curr_node->parent_->left_node_ = pos.curr_node->right_node_;
+        current = current->right_node_;
       }
     }
-    --tree_size;
-    delete pos.curr_node;
+    return result;
   }
 
-  void swap(tree &other) noexcept {
-    std::swap(root_node, other.root_node);
-    std::swap(node, other.node);
-    std::swap(tree_size, other.tree_size);
+  template <typename... Args>
+  Node *create_node(Args &&...args) {
+    Node *new_node = node_traits::allocate(GetAllocator(), 1);
+    try {
+      ::new (static_cast<void *>(new_node)) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(GetAllocator(), new_node, 1);
+      throw;
+    }
+    return new_node;
   }
 
-  void merge(tree &other) { default_merge(other, other.root_node); }
-
-  iterator find(const key_type &key) noexcept {
-    Node *node = find_contains(key);
-    if (node->value_ != key) return iterator(nullptr);
-    return iterator(node);
+  void destroy(Node *old_node) noexcept {
+    old_node->~Node();
+    node_traits::deallocate(GetAllocator(), old_node, 1);
   }
 
-  [[nodiscard]] bool contains(const key_type &key) noexcept {
-    Node *node = find_contains(key);
-    return !(!node || node->value_ != key);
+  /* Frees a subtree in O(1) stack space: left children are rotated up
+   * until the node has none, then the node is freed and its right subtree
+   * is next */
+  void destroy_node(NodeBase *item) noexcept {
+    while (item) {
+      if (item->left_node_) {
+        NodeBase *left = item->left_node_;
+        item->left_node_ = left->right_node_;
+        left->right_node_ = item;
+        item = left;
+      } else {
+        NodeBase *right = item->right_node_;
+        destroy(static_cast<Node *>(item));
+        item = right;
+      }
+    }
   }
 
- protected:
-  std::pair<iterator, bool> auto_insert(const value_type &value, bool multi) {
-    if (!multi && contains(value)) {
-      iterator find_node = find(value);
-      return std::make_pair(find_node, false);
-    }
-    iterator iter = default_insert(value);
-    return std::make_pair(iter, true);
-  }
-
-  void default_merge(tree &other, Node *item) {
-    if (item->right_node_) default_merge(other, item->right_node_);
-    if (item->left_node_) default_merge(other, item->left_node_);
-    insert(item->value_);
-    auto iter = iterator(item);
-    other.erase(iter);
-  }
-
-  iterator default_insert(const value_type &value) {
-    auto *new_node = new Node(value);
-    if (root_node == node) {
-      root_node = new_node;
-      node->parent_ = new_node;
-      node->left_node_ = new_node;
-      node->right_node_ = new_node;
-      new_node->parent_ = node;
-    } else {
-      Node *buff = root_node;
+  /* Copies the shape, colours and values of other node by node, so the
+   * copy is balanced exactly like other and no key is compared. The walk
+   * follows parent links and needs no stack. This tree must be empty */
+  void copy_tree(const tree &other) {
+    const NodeBase *source = other.root();
+    if (!source) return;
+    try {
+      NodeBase *target = clone_node(source);
+      target->parent_ = &end_node;
+      end_node.parent_ = target;
       while (true) {
-        if (buff->value_ > new_node->value_) {
-          if (buff->left_node_) {
-            buff = buff->left_node_;
-          } else {
-            buff->left_node_ = new_node;
-            new_node->parent_ = buff;
-            if (node->right_node_->value_ > new_node->value_) {
-              node->right_node_ = new_node;
-            }
-            break;
-          }
+        if (source->left_node_ && !target->left_node_) {
+          target->left_node_ = clone_node(source->left_node_);
+          target->left_node_->parent_ = target;
+          source = source->left_node_;
+          target = target->left_node_;
+        } else if (source->right_node_ && !target->right_node_) {
+          target->right_node_ = clone_node(source->right_node_);
+          target->right_node_->parent_ = target;
+          source = source->right_node_;
+          target = target->right_node_;
+        } else if (source != other.root()) {
+          source = source->parent_;
+          target = target->parent_;
         } else {
-          if (buff->right_node_) {
-            buff = buff->right_node_;
-          } else {
-            buff->right_node_ = new_node;
-            new_node->parent_ = buff;
-            if (node->left_node_->value_ < new_node->value_) {
-              node->left_node_ = new_node;
-            }
-            break;
-          }
+          break;
         }
       }
+    } catch (...) {
+      clear();
+      throw;
     }
-    ++tree_size;
-    return Iterator(new_node);
+    NodeBase *first = root();
+    while (first->left_node_) first = first->left_node_;
+    NodeBase *last = root();
+    while (last->right_node_) last = last->right_node_;
+    end_node.right_node_ = first;
+    end_node.left_node_ = last;
+    tree_size = other.tree_size;
   }
 
-  Node *find_contains(const key_type &key) {
-    if (empty()) return nullptr;
-    Node *current = root_node;
-    while (true) {
-      if (current == nullptr) {
-        return nullptr;
-      } else if (current->value_ == key) {
-        return current;
-      } else if (current->value_ > key) {
-        if (!current->left_node_) return current;
+  Node *clone_node(const NodeBase *source) {
+    const Node *item = static_cast<const Node *>(source);
+    Node *copy = create_node(item->value_);
+    copy->is_red = item->is_red;
+    if constexpr (Ranked) copy->subtree_size = item->subtree_size;
+    return copy;
+  }
+
+  /* Turns the right-leaning chain of tree_size nodes hanging from the end
+   * node into a balanced tree with the Day-Stout-Warren compressions:
+   * O(n) left rotations and no comparisons. The first pass moves the
+   * nodes of an incomplete bottom level into place, those are coloured red
+   * and every other node black, which satisfies the red-black rules */
+  void chain_to_tree() noexcept {
+    size_type full = 1;
+    while (full * 2 + 1 <= tree_size) full = full * 2 + 1;
+    compress_chain(tree_size - full, true);
+    for (size_type size = full / 2; size > 0; size /= 2) {
+      compress_chain(size, false);
+    }
+  }
+
+  /* Rotates every second node of the right spine down to the left of its
+   * successor, count times */
+  void compress_chain(size_type count, bool red) noexcept {
+    NodeBase *item = root();
+    for (size_type i = 0; i < count; ++i) {
+      NodeBase *pivot = item->right_node_;
+      rotate_left(item);
+      item->is_red = red;
+      item = pivot->right_node_;
+    }
+  }
+
+  /* Moves all nodes of other to this tree, this tree must be empty. The
+   * end node lives inside the tree object, so only the root is relinked */
+  void take_nodes(tree &other) noexcept {
+    if (other.empty()) return;
+    end_node.parent_ = other.end_node.parent_;
+    end_node.left_node_ = other.end_node.left_node_;
+    end_node.right_node_ = other.end_node.right_node_;
+    end_node.parent_->parent_ = &end_node;
+    tree_size = other.tree_size;
+    other.root_is_empty();
+  }
+
+  static bool is_red(const NodeBase *item) noexcept {
+    return item && item->is_red;
+  }
+
+  /* Puts replacement in the place of item under item's parent */
+  void replace_child(NodeBase *item, NodeBase *replacement) noexcept {
+    if (item == root()) {
+      end_node.parent_ = replacement;
+    } else if (item == item->parent_->left_node_) {
+      item->parent_->left_node_ = replacement;
+    } else {
+      item->parent_->right_node_ = replacement;
+    }
+  }
+
+  void transplant(NodeBase *item, NodeBase *replacement) noexcept {
+    replace_child(item, replacement);
+    if (replacement) replacement->parent_ = item->parent_;
+  }
+
+  void rotate_left(NodeBase *item) noexcept {
+    NodeBase *pivot = item->right_node_;
+    item->right_node_ = pivot->left_node_;
+    if (pivot->left_node_) pivot->left_node_->parent_ = item;
+    transplant(item, pivot);
+    pivot->left_node_ = item;
+    item->parent_ = pivot;
+    rotate_sizes(item, pivot);
+  }
+
+  void rotate_right(NodeBase *item) noexcept {
+    NodeBase *pivot = item->left_node_;
+    item->left_node_ = pivot->right_node_;
+    if (pivot->right_node_) pivot->right_node_->parent_ = item;
+    transplant(item, pivot);
+    pivot->right_node_ = item;
+    item->parent_ = pivot;
+    rotate_sizes(item, pivot);
+  }
+
+  /* pivot took the place of item, which became its child */
+  static void rotate_sizes(NodeBase *item, NodeBase *pivot) noexcept {
+    if constexpr (Ranked) {
+      as_node(pivot)->subtree_size = as_node(item)->subtree_size;
+      as_node(item)->subtree_size = subtree_size(item->left_node_) +
+                                    subtree_size(item->right_node_) + 1;
+    }
+  }
+
+  static Node *as_node(NodeBase *item) noexcept {
+    return static_cast<Node *>(item);
+  }
+
+  static size_type subtree_size(const NodeBase *item) noexcept {
+    static_assert(Ranked, "subtree sizes are kept by ranked trees only");
+    return item ? static_cast<const Node *>(item)->subtree_size : 0;
+  }
+
+  /* Adds delta to the sizes of item and all its ancestors */
+  void resize_path(NodeBase *item, int delta) noexcept {
+    for (; item != &end_node; item = item->parent_) {
+      as_node(item)->subtree_size += delta;
+    }
+  }
+
+  NodeBase *nth_node(size_type k) const noexcept {
+    NodeBase *current = root();
+    while (current) {
+      size_type left = subtree_size(current->left_node_);
+      if (k < left) {
         current = current->left_node_;
+      } else if (k == left) {
+        return current;
       } else {
-        if (!current->right_node_) return current;
+        k -= left + 1;
         current = current->right_node_;
       }
     }
+    return const_cast<NodeBase *>(&end_node);
   }
 
-  void destroy_node(Node *root) {
-    if (root->left_node_) destroy_node(root->left_node_);
-    if (root->right_node_) destroy_node(root->right_node_);
-    delete root;
+  size_type index_of(const NodeBase *item) const noexcept {
+    if (item == &end_node) return tree_size;
+    size_type result = subtree_size(item->left_node_);
+    for (; item != root(); item = item->parent_) {
+      if (item == item->parent_->right_node_) {
+        result += subtree_size(item->parent_->left_node_) + 1;
+      }
+    }
+    return result;
   }
 
-  void root_is_empty() {
-    node->is_empty = true;
-    node->parent_ = node;
-    node->left_node_ = node;
-    node->right_node_ = node;
-    root_node = node;
-    tree_size = 0;
+  /* Restores the red-black properties after item was linked as a red leaf */
+  void insert_fixup(NodeBase *item) noexcept {
+    while (item != root() && is_red(item->parent_)) {
+      NodeBase *parent = item->parent_;
+      NodeBase *grand = parent->parent_;
+      if (parent == grand->left_node_) {
+        NodeBase *uncle = grand->right_node_;
+        if (is_red(uncle)) {
+          parent->is_red = false;
+          uncle->is_red = false;
+          grand->is_red = true;
+          item = grand;
+          continue;
+        }
+        if (item == parent->right_node_) {
+          rotate_left(parent);
+          item = parent;
+          parent = item->parent_;
+        }
+        parent->is_red = false;
+        grand->is_red = true;
+        rotate_right(grand);
+      } else {
+        NodeBase *uncle = grand->left_node_;
+        if (is_red(uncle)) {
+          parent->is_red = false;
+          uncle->is_red = false;
+          grand->is_red = true;
+          item = grand;
+          continue;
+        }
+        if (item == parent->left_node_) {
+          rotate_right(parent);
+          item = parent;
+          parent = item->parent_;
+        }
+        parent->is_red = false;
+        grand->is_red = true;
+        rotate_left(grand);
+      }
+    }
+    root()->is_red = false;
   }
 
-  void copy_tree(const Node *other) {
-    default_insert(other->value_);
-    if (other->left_node_) copy_tree(other->left_node_);
-    if (other->right_node_) copy_tree(other->right_node_);
+  /* Restores the red-black properties after a black node was unlinked,
+   * item (possibly null) took its place under parent */
+  void erase_fixup(NodeBase *item, NodeBase *parent) noexcept {
+    while (item != root() && !is_red(item)) {
+      if (item == parent->left_node_) {
+        NodeBase *sibling = parent->right_node_;
+        if (sibling->is_red) {
+          sibling->is_red = false;
+          parent->is_red = true;
+          rotate_left(parent);
+          sibling = parent->right_node_;
+        }
+        if (!is_red(sibling->left_node_) && !is_red(sibling->right_node_)) {
+          sibling->is_red = true;
+          item = parent;
+          parent = item->parent_;
+        } else {
+          if (!is_red(sibling->right_node_)) {
+            sibling->left_node_->is_red = false;
+            sibling->is_red = true;
+            rotate_right(sibling);
+            sibling = parent->right_node_;
+          }
+          sibling->is_red = parent->is_red;
+          parent->is_red = false;
+          sibling->right_node_->is_red = false;
+          rotate_left(parent);
+          item = root();
+        }
+      } else {
+        NodeBase *sibling = parent->left_node_;
+        if (sibling->is_red) {
+          sibling->is_red = false;
+          parent->is_red = true;
+          rotate_right(parent);
+          sibling = parent->left_node_;
+        }
+        if (!is_red(sibling->left_node_) && !is_red(sibling->right_node_)) {
+          sibling->is_red = true;
+          item = parent;
+          parent = item->parent_;
+        } else {
+          if (!is_red(sibling->left_node_)) {
+            sibling->right_node_->is_red = false;
+            sibling->is_red = true;
+            rotate_left(sibling);
+            sibling = parent->left_node_;
+          }
+          sibling->is_red = parent->is_red;
+          parent->is_red = false;
+          sibling->left_node_->is_red = false;
+          rotate_right(parent);
+          item = root();
+        }
+      }
+    }
+    if (item) item->is_red = false;
   }
 
-  Node *return_root() noexcept { return root_node; }
+  void root_is_empty() noexcept {
+    end_node.is_empty = true;
+    end_node.is_red = false;
+    end_node.parent_ = nullptr;
+    end_node.left_node_ = &end_node;
+    end_node.right_node_ = &end_node;
+    tree_size = 0;
+  }
 };
 
 }  // namespace s21
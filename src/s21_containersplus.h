@@ -2,6 +2,15 @@
 #define S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
 
 #include "containers/s21_array.h"
+#include "containers/s21_btree_map.h"
+#include "containers/s21_flat_map.h"
+#include "containers/s21_flat_set.h"
+#include "containers/s21_multimap.h"
 #include "containers/s21_multiset.h"
+#include "containers/s21_pool_allocator.h"
+#include "containers/s21_ring_buffer.h"
+#include "containers/s21_small_vector.h"
+#include "containers/s21_unordered_map.h"
+#include "containers/s21_unordered_set.h"
 
 #endif  // S21_CONTAINERS_SRC_S21_CONTAINERSPLUS_H_